@@ -0,0 +1,43 @@
+#include "../gidunit.h"
+
+volatile int64_t sink;
+
+BEGIN_TEST_SUITE(Benchmarks)
+
+  SetUp()
+  {
+    //Runs once per configuration, not once per iteration
+    fixture = calloc(65536, 1);
+    assert_not_null(fixture);
+  }
+
+  TearDown()
+  {
+    free(fixture);
+  }
+
+  Benchmark(MemsetSpeed,
+    EnumParam(size, 64, 4096, 65536))
+  {
+    memset(fixture, 0, size);
+    set_bytes_per_op(size);
+  }
+
+  Benchmark(SumSpeed,
+    EnumParam(count, 16, 1024, 16384))
+  {
+    const int32_t* values = fixture;
+    int64_t sum = 0;
+    for(int64_t i = 0; i < count; i++)
+      sum += values[i];
+    sink = sum;//Keeps the loop from being optimized away
+    set_bytes_per_op(count * sizeof(int32_t));
+  }
+
+END_TEST_SUITE()
+
+int main()
+{
+  ADD_TEST_SUITE(Benchmarks);
+  return gidunit();
+}
@@ -0,0 +1,44 @@
+#include "../gidunit.h"
+
+BEGIN_TEST_SUITE(CoveringArrays)
+
+  Test(FormatFitsWidth,
+    Pairwise()
+    EnumParam(width, 0, 1, 8, 16)
+    EnumParam(precision, 0, 2, 6)
+    StringEnumParam(flag, "", "-", "+", "0", " ")
+    EnumParam(value, -1, 0, 1, 1000000))
+  {
+    //Every combination would be 4*3*5*4=240 configurations, but every pair of
+    //values of every two parameters is covered by about 20 of them
+    char format[16];
+    char buffer[64];
+    snprintf(format, sizeof(format), "%%%s*.*f", flag);
+    int length = snprintf(buffer, sizeof(buffer), format, (int)width, (int)precision, (double)value);
+    assert(length >= width);
+    assert(length < 64);
+  }
+
+  Test(ClampStaysInRange,
+    CoveringArray(3)
+    RangeParam(x, -4, 4)
+    RangeParam(low, -2, 0)
+    RangeParam(high, 0, 2)
+    UnsignedEnumParam(repeat, 1, 2))
+  {
+    //Every triple of values of every three parameters is covered by 81 of the
+    //9*3*3*2=162 configurations
+    int64_t clamped = x;
+    for(uint64_t i = 0; i < repeat; i++)
+      clamped = clamped < low ? low : (clamped > high ? high : clamped);
+    assert(clamped >= low);
+    assert(clamped <= high);
+  }
+
+END_TEST_SUITE()
+
+int main()
+{
+  ADD_TEST_SUITE(CoveringArrays);
+  return gidunit();
+}
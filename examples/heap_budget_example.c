@@ -0,0 +1,66 @@
+//Build with the GNU linker's wrap option, so the heap allocations are counted:
+//gcc -I.. heap_budget_example.c -pthread -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+#define GID_WRAP_MALLOC
+#include "../gidunit.h"
+
+/* Appends 'count' integers to an array that grows by 'growth' elements
+ * whenever it is full, or doubles if 'growth' is zero.
+ * @returns - The array, which the caller must free. */
+int64_t* fill_array(int64_t count, int64_t growth)
+{
+  int64_t* values = NULL;
+  int64_t capacity = 0;
+  for(int64_t i = 0; i < count; i++)
+  {
+    if(i == capacity)
+    {
+      capacity = growth > 0 ? capacity + growth : (capacity == 0 ? 1 : capacity * 2);
+      values = realloc(values, sizeof(int64_t) * capacity);
+    }
+    values[i] = i;
+  }
+  return values;
+}
+
+BEGIN_TEST_SUITE(HeapBudgets)
+
+  Test(FillArrayGrowsGeometrically,
+    AllocCountBudget(16)
+    EnumParam(count, 10, 100, 1000)
+    EnumParam(growth, 0, 1))
+  {
+    //Growing by one element at a time reallocates for every value, so the
+    //configurations with growth=1 and count>10 go over the budget and fail
+    int64_t* values = fill_array(count, growth);
+    assert_int_eq(count - 1, values[count - 1]);
+    free(values);
+  }
+
+  Test(CopyFitsInBudget,
+    PeakHeapBudget(4096)
+    EnumParam(length, 16, 256, 8192))
+  {
+    //length=8192 needs more than 4096 bytes at once, so it fails
+    char* copy = malloc(length);
+    assert_not_null(copy);
+    memset(copy, 'x', length);
+    free(copy);
+  }
+
+  Test(ScratchIsSmall,
+    EnumParam(size, 64, 512))
+  {
+    //Heap usage can also be asserted partway through a test
+    void* scratch = malloc(size);
+    assert_peak_heap_below(1024);
+    assert_alloc_count_below(2);
+    free(scratch);
+  }
+
+END_TEST_SUITE()
+
+int main()
+{
+  ADD_TEST_SUITE(HeapBudgets);
+  return gidunit();
+}
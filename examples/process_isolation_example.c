@@ -0,0 +1,33 @@
+#include "../gidunit.h"
+
+static const char* dayNames[] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun", NULL };
+
+BEGIN_TEST_SUITE(ProcessIsolation)
+
+  Test(DayNamesHaveThreeLetters,
+    RangeParam(day, 0, 7))
+  {
+    //There are only 7 days, so day=7 gets NULL and crashes its worker process.
+    //That configuration fails with the signal, and the others still run.
+    assert_int_eq(3, strlen(dayNames[day]));
+  }
+
+  Test(RejectsNegativeSizes,
+    EnumParam(size, 1, 16, -1, 256))
+  {
+    //Aborting only ends the worker process that runs this configuration
+    if(size < 0)
+      abort();
+    assert(size > 0);
+  }
+
+END_TEST_SUITE()
+
+int main()
+{
+  //Run in worker processes, so a crash doesn't end the whole run. Setting
+  //GID_PROCESSES in the environment overrides this.
+  setenv("GID_PROCESSES", "2", 0);
+  ADD_TEST_SUITE(ProcessIsolation);
+  return gidunit();
+}
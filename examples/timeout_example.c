@@ -0,0 +1,34 @@
+#include "../gidunit.h"
+
+/* Counts down from 'start' to zero, two at a time. There is a bug: an odd
+ * 'start' skips over zero, so it never stops. */
+uint64_t count_down_by_two(uint64_t start)
+{
+  volatile uint64_t n = start;
+  uint64_t steps = 0;
+  while(n != 0)
+  {
+    n -= 2;
+    steps++;
+  }
+  return steps;
+}
+
+BEGIN_TEST_SUITE(Timeouts)
+
+  Test(CountDownFinishes,
+    Timeout(200)
+    UnsignedEnumParam(start, 0, 2, 1000, 7, 100000))
+  {
+    //start=7 never finishes, so it fails with a timeout after 200 ms, and the
+    //other configurations keep running
+    assert_uint_eq(start / 2, count_down_by_two(start));
+  }
+
+END_TEST_SUITE()
+
+int main()
+{
+  ADD_TEST_SUITE(Timeouts);
+  return gidunit();
+}
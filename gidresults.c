@@ -0,0 +1,410 @@
+/*
+
+@file gidresults.c - Reads the binary results file that gidunit writes when
+      the GID_RESULTS option is set (see GIDResultsHeader in gidunit.h). The
+      file is memory-mapped rather than read, so queries over millions of
+      results only touch the records they need.
+
+@author - Aaron Leggett
+@repo - https://github.com/a-leggett/GIDUnit
+
+@license - This software is available under The Unlicense or the MIT license,
+   whichever you prefer. See gidunit.h for the full text of both.
+
+@example
+
+cc -o gidresults gidresults.c -pthread
+./gidresults results.bin summary
+./gidresults results.bin slowest 100
+./gidresults results.bin failures MySuite.MyTest
+
+*/
+
+#include "gidunit.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+/* A results file that is mapped into memory. */
+typedef struct GIDResultsView
+{
+  /* The header of the file. If the run didn't finish, the counts are found
+   * from the size of the file instead. */
+  GIDResultsHeader header;
+
+  /* Pointer to the first GIDResultsRecord. */
+  const GIDResultsRecord* records;
+
+  /* Pointer to the first GIDResultsTest, or NULL if the run didn't
+   * finish. */
+  const GIDResultsTest* tests;
+
+  /* Pointer to the string table, or NULL if the run didn't finish. */
+  const char* strings;
+
+  /* The mapped file. */
+  const uint8_t* data;
+
+  /* The size of the mapped file, in bytes. */
+  uint64_t size;
+
+#ifdef _WIN32
+  /* The handle of the file mapping. */
+  HANDLE mapping;
+#endif
+} GIDResultsView;
+
+/* Maps a results file into memory, and checks its header.
+ * @param path - The path of the file.
+ * @param view - Pointer to the GIDResultsView to initialize.
+ * @returns - Zero if the file couldn't be mapped or isn't a results file,
+ *          otherwise non-zero. */
+int _gid_map_results(const char* path, GIDResultsView* view)
+{
+  memset(view, 0, sizeof(GIDResultsView));
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if(file == INVALID_HANDLE_VALUE)
+    return 0;
+  LARGE_INTEGER size;
+  if(!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(GIDResultsHeader))
+  {
+    CloseHandle(file);
+    return 0;
+  }
+  view->mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if(view->mapping == NULL)
+    return 0;
+  view->data = MapViewOfFile(view->mapping, FILE_MAP_READ, 0, 0, 0);
+  view->size = (uint64_t)size.QuadPart;
+  if(view->data == NULL)
+  {
+    CloseHandle(view->mapping);
+    return 0;
+  }
+#else
+  int fd = open(path, O_RDONLY);
+  if(fd < 0)
+    return 0;
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(GIDResultsHeader))
+  {
+    close(fd);
+    return 0;
+  }
+  void* data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED)
+    return 0;
+  view->data = data;
+  view->size = st.st_size;
+#endif
+
+  memcpy(&view->header, view->data, sizeof(GIDResultsHeader));
+  GIDResultsHeader* header = &view->header;
+  if(memcmp(header->magic, GID_RESULTS_MAGIC, sizeof(GID_RESULTS_MAGIC)) != 0
+    || header->version != GID_RESULTS_VERSION
+    || header->record_size != sizeof(GIDResultsRecord))
+  {
+    return 0;
+  }
+
+  uint64_t recordsSize = view->size - sizeof(GIDResultsHeader);
+  view->records = (const GIDResultsRecord*)
+    (view->data + sizeof(GIDResultsHeader));
+  if(header->strings_offset == 0)
+  {
+    //The run didn't finish, so only the records that were written are known
+    header->record_count = recordsSize / sizeof(GIDResultsRecord);
+    header->test_count = 0;
+    return 1;
+  }
+  if(header->record_count > recordsSize / sizeof(GIDResultsRecord)
+    || header->strings_offset > view->size
+    || header->strings_size > view->size - header->strings_offset
+    || header->tests_offset > header->strings_offset
+    || header->test_count > (header->strings_offset - header->tests_offset)
+      / sizeof(GIDResultsTest))
+  {
+    return 0;
+  }
+  view->tests = (const GIDResultsTest*)(view->data + header->tests_offset);
+  view->strings = (const char*)(view->data + header->strings_offset);
+  return 1;
+}
+
+/* Unmaps a results file.
+ * @param view - Pointer to the GIDResultsView of the file. */
+void _gid_unmap_results(GIDResultsView* view)
+{
+  if(view->data == NULL)
+    return;
+#ifdef _WIN32
+  UnmapViewOfFile(view->data);
+  CloseHandle(view->mapping);
+#else
+  munmap((void*)view->data, view->size);
+#endif
+  view->data = NULL;
+}
+
+/* Gets a string from the string table of a results file.
+ * @param view - Pointer to the GIDResultsView of the file.
+ * @param offset - The offset of the string in the string table.
+ * @returns - The string, or "?" if the offset isn't valid. */
+const char* _gid_get_results_string(const GIDResultsView* view, uint64_t offset)
+{
+  if(view->strings == NULL || offset >= view->header.strings_size)
+    return "?";
+  return view->strings + offset;
+}
+
+/* Prints the name of the test of a record, as 'Suite.Test'.
+ * @param view - Pointer to the GIDResultsView of the file.
+ * @param record - Pointer to the GIDResultsRecord. */
+void _gid_print_results_test(
+  const GIDResultsView* view,
+  const GIDResultsRecord* record)
+{
+  if(record->test_index >= view->header.test_count)
+  {
+    printf("#%"PRIu32".#%"PRIu32, record->suite_index, record->test_index);
+    return;
+  }
+  const GIDResultsTest* test = &view->tests[record->test_index];
+  printf("%s.%s",
+    _gid_get_results_string(view, test->suite_name),
+    _gid_get_results_string(view, test->name));
+}
+
+/* Prints a record, and the text of its failures, if any.
+ * @param view - Pointer to the GIDResultsView of the file.
+ * @param record - Pointer to the GIDResultsRecord. */
+void _gid_print_results_record(
+  const GIDResultsView* view,
+  const GIDResultsRecord* record)
+{
+  const char* statusNames[4] = { "pending", "failed", "skipped", "passed" };
+  char runtime[32];
+  _gid_format_duration((double)record->runtime, runtime, sizeof(runtime));
+  _gid_print_results_test(view, record);
+  printf(" configuration %"PRIu64": %s in %s\n",
+    record->configuration_index,
+    record->status < 4 ? statusNames[record->status] : "?",
+    runtime);
+  if(record->failure != UINT64_MAX)
+    printf("%s", _gid_get_results_string(view, record->failure));
+}
+
+/* Prints the number of records with each status, for each test.
+ * @param view - Pointer to the GIDResultsView of the file. */
+void _gid_query_summary(const GIDResultsView* view)
+{
+  uint64_t testCount = view->header.test_count;
+  uint64_t* counts = calloc((testCount + 1) * 4, sizeof(uint64_t));
+  uint64_t* runtimes = calloc(testCount + 1, sizeof(uint64_t));
+  for(uint64_t i = 0; i < view->header.record_count; i++)
+  {
+    const GIDResultsRecord* record = &view->records[i];
+    uint64_t test = record->test_index < testCount
+      ? record->test_index
+      : testCount;
+    counts[test * 4 + (record->status < 4 ? record->status : 0)]++;
+    runtimes[test] += record->runtime;
+  }
+
+  printf("%"PRIu64" results of %"PRIu64" tests in %"PRIu32" suites%s.\n",
+    view->header.record_count,
+    testCount,
+    view->header.suite_count,
+    view->strings == NULL ? " (the run didn't finish)" : "");
+  for(uint64_t test = 0; test <= testCount; test++)
+  {
+    uint64_t* c = &counts[test * 4];
+    if(c[GID_RUN_RESULT_PASSED] + c[GID_RUN_RESULT_FAILED]
+      + c[GID_RUN_RESULT_SKIPPED] + c[GID_RUN_RESULT_PENDING] == 0)
+    {
+      continue;
+    }
+    char runtime[32];
+    _gid_format_duration((double)runtimes[test], runtime, sizeof(runtime));
+    if(test < testCount)
+    {
+      printf("%s.%s",
+        _gid_get_results_string(view, view->tests[test].suite_name),
+        _gid_get_results_string(view, view->tests[test].name));
+    }
+    else
+    {
+      printf("(unknown tests)");
+    }
+    printf(": %"PRIu64" passed, %"PRIu64" failed, %"PRIu64" skipped in %s\n",
+      c[GID_RUN_RESULT_PASSED],
+      c[GID_RUN_RESULT_FAILED],
+      c[GID_RUN_RESULT_SKIPPED],
+      runtime);
+  }
+  free(counts);
+  free(runtimes);
+}
+
+/* Restores the order of a min-heap of records, ordered by runtime, after the
+ * record at a position was replaced by a slower one.
+ * @param heap - The heap of pointers to GIDResultsRecords.
+ * @param count - The number of records in the heap.
+ * @param pos - The position of the record that was replaced. */
+void _gid_sift_down_results(
+  const GIDResultsRecord** heap,
+  size_t count,
+  size_t pos)
+{
+  while(1)
+  {
+    size_t min = pos;
+    size_t left = pos * 2 + 1;
+    size_t right = left + 1;
+    if(left < count && heap[left]->runtime < heap[min]->runtime)
+      min = left;
+    if(right < count && heap[right]->runtime < heap[min]->runtime)
+      min = right;
+    if(min == pos)
+      return;
+    const GIDResultsRecord* tmp = heap[pos];
+    heap[pos] = heap[min];
+    heap[min] = tmp;
+    pos = min;
+  }
+}
+
+/* Compares two pointers to GIDResultsRecords, for qsort, so the slower one
+ * comes first. */
+int _gid_compare_results_runtime(const void* a, const void* b)
+{
+  uint64_t ra = (*(const GIDResultsRecord* const*)a)->runtime;
+  uint64_t rb = (*(const GIDResultsRecord* const*)b)->runtime;
+  return ra < rb ? 1 : (ra > rb ? -1 : 0);
+}
+
+/* Prints the slowest records, slowest first. The records are kept in a heap
+ * of the requested size, so this is one pass over the file.
+ * @param view - Pointer to the GIDResultsView of the file.
+ * @param count - The number of records to print. */
+void _gid_query_slowest(const GIDResultsView* view, size_t count)
+{
+  const GIDResultsRecord** heap = malloc(
+    sizeof(GIDResultsRecord*) * (count + 1));
+  size_t size = 0;
+  for(uint64_t i = 0; i < view->header.record_count; i++)
+  {
+    const GIDResultsRecord* record = &view->records[i];
+    if(size < count)
+    {
+      //Sift up
+      size_t pos = size++;
+      heap[pos] = record;
+      while(pos > 0 && heap[(pos - 1) / 2]->runtime > heap[pos]->runtime)
+      {
+        heap[pos] = heap[(pos - 1) / 2];
+        heap[(pos - 1) / 2] = record;
+        pos = (pos - 1) / 2;
+      }
+    }
+    else if(count > 0 && record->runtime > heap[0]->runtime)
+    {
+      heap[0] = record;
+      _gid_sift_down_results(heap, size, 0);
+    }
+  }
+  qsort(heap, size, sizeof(GIDResultsRecord*), _gid_compare_results_runtime);
+  for(size_t i = 0; i < size; i++)
+    _gid_print_results_record(view, heap[i]);
+  free(heap);
+}
+
+/* Prints the records that failed, in the order that they finished.
+ * @param view - Pointer to the GIDResultsView of the file.
+ * @param name - The name of the test whose failures to print, as 'Test' or
+ *        'Suite.Test', or NULL to print the failures of all tests. */
+void _gid_query_failures(const GIDResultsView* view, const char* name)
+{
+  //Find the matching tests once, rather than comparing names per record
+  uint64_t testCount = view->header.test_count;
+  uint8_t* isMatch = calloc(testCount + 1, 1);
+  for(uint64_t i = 0; i < testCount; i++)
+  {
+    const char* suiteName = _gid_get_results_string(
+      view,
+      view->tests[i].suite_name);
+    const char* testName = _gid_get_results_string(view, view->tests[i].name);
+    size_t suiteLen = strlen(suiteName);
+    isMatch[i] = name == NULL
+      || strcmp(name, testName) == 0
+      || (strncmp(name, suiteName, suiteLen) == 0
+        && name[suiteLen] == '.'
+        && strcmp(name + suiteLen + 1, testName) == 0);
+  }
+  isMatch[testCount] = name == NULL;
+
+  uint64_t failCount = 0;
+  for(uint64_t i = 0; i < view->header.record_count; i++)
+  {
+    const GIDResultsRecord* record = &view->records[i];
+    uint64_t test = record->test_index < testCount
+      ? record->test_index
+      : testCount;
+    if(record->status == GID_RUN_RESULT_FAILED && isMatch[test])
+    {
+      _gid_print_results_record(view, record);
+      failCount++;
+    }
+  }
+  printf("%"PRIu64" failures.\n", failCount);
+  free(isMatch);
+}
+
+int main(int argc, char** argv)
+{
+  if(argc < 3)
+  {
+    printf("Usage: %s FILE summary\n"
+      "       %s FILE slowest [COUNT]\n"
+      "       %s FILE failures [TEST]\n",
+      argv[0], argv[0], argv[0]);
+    return 2;
+  }
+
+  GIDResultsView view;
+  if(!_gid_map_results(argv[1], &view))
+  {
+    printf("Couldn't read the results file %s.\n", argv[1]);
+    _gid_unmap_results(&view);
+    return 1;
+  }
+
+  int ret = 0;
+  if(strcmp(argv[2], "summary") == 0)
+  {
+    _gid_query_summary(&view);
+  }
+  else if(strcmp(argv[2], "slowest") == 0)
+  {
+    int count = argc > 3 ? atoi(argv[3]) : 100;
+    _gid_query_slowest(&view, count > 0 ? (size_t)count : 0);
+  }
+  else if(strcmp(argv[2], "failures") == 0)
+  {
+    _gid_query_failures(&view, argc > 3 ? argv[3] : NULL);
+  }
+  else
+  {
+    printf("Unknown query %s.\n", argv[2]);
+    ret = 2;
+  }
+  _gid_unmap_results(&view);
+  return ret;
+}
@@ -132,17 +132,51 @@ int main()
 #ifdef _MSC_VER
 #define _CRT_SECURE_NO_WARNINGS
 #endif
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+//Exposes POSIX functions like clock_gettime, even with -std=c99
+#define _DEFAULT_SOURCE
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 #include <inttypes.h>
+#include <time.h>
 
 #ifdef _WIN32
 #include <Windows.h>
+#include <io.h>
 #else
-#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <errno.h>
+#endif
+#ifdef GID_WRAP_MALLOC
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#ifdef __linux__
+//If a system header was included before gidunit.h under a strict C mode
+//(such as -std=c99), _DEFAULT_SOURCE came too late to expose these
+#ifndef CLOCK_MONOTONIC
+#define CLOCK_MONOTONIC 1
+#endif
+int clock_gettime(clockid_t clockId, struct timespec* time);
+int fileno(FILE* stream);
+int kill(pid_t pid, int sig);
+char* strsignal(int sig);
+long syscall(long number, ...);
 #endif
 
 #ifndef GIDUNIT_H
@@ -151,6 +185,15 @@ int main()
 /* The maximum length of an assert failure message. */
 #define GID_MAX_MESSAGE_LENGTH (256)
 
+/* The number of example configurations that are kept, and printed, for each
+ * group of failures of a test that have the same cause (see
+ * GIDFailureGroup). */
+#define GID_MAX_FAILURE_EXAMPLES (3)
+
+/* The largest number of groups of failures that are kept for each test.
+ * Failures with a different cause than all of the groups are only counted. */
+#define GID_MAX_FAILURE_GROUPS (32)
+
 /*  The maximum length of the string representation of a test configuration
  * (that is, the string that shows the values of each variable in a test). */
 #define GID_MAX_CONFIGURATION_STRING_LENGTH (256)
@@ -159,6 +202,43 @@ int main()
  * that is allocated by the gid_malloc function. */
 #define GID_MALLOC_PADDING (32)
 
+/* Define GID_WRAP_MALLOC before including gidunit.h to count the heap
+ * allocations of each step of each configuration (see GIDHeapStats). The
+ * program must be linked with the GNU linker's wrap option, which sends the
+ * calls to malloc, calloc, realloc and free to the wrappers in this file:
+ *   -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ * Sizes are read with malloc_usable_size, so this needs glibc (or another
+ * C library that has it). */
+
+/* The number of consecutive batches of a Benchmark whose times must agree
+ * (within GID_BENCHMARK_TOLERANCE) before the measurement is finished. */
+#define GID_BENCHMARK_SAMPLE_COUNT (5)
+
+/* The largest number of batches that a Benchmark measures for each
+ * configuration, even if their times never agree. */
+#define GID_BENCHMARK_MAX_SAMPLE_COUNT (50)
+
+/* How far apart the fastest and slowest of the recent batches of a
+ * Benchmark may be, relative to the fastest, for the times to agree. */
+#define GID_BENCHMARK_TOLERANCE (0.05)
+
+/* The largest number of iterations in one batch of a Benchmark. A body that
+ * the compiler optimized away never reaches the target time, so its batches
+ * stop growing here. */
+#define GID_BENCHMARK_MAX_ITERATIONS (1000000000)
+
+/* The number of hardware performance counters that are measured for each
+ * configuration when the GID_PERF_COUNTERS option is set. */
+#define GID_PERF_COUNTER_COUNT (6)
+
+/* The largest number of values that a parameter may have for the performance
+ * counters of a test to be broken down by each of its values. */
+#define GID_MAX_PERF_BREAKDOWN_VALUES (16)
+
+/* The size of the buffer in which JSON events are formatted before they are
+ * written (see the GID_EVENTS option). */
+#define GID_EVENT_BUFFER_SIZE (65536)
+
 /* Checks how many bytes of memory are equivalent.
  * @param a - Pointer to the first memory object.
  * @param b - Pointer to the second memory object.
@@ -178,66 +258,287 @@ size_t _gid_cmp_memory(const uint8_t* a, const uint8_t* b, size_t size)
   return match;
 }
 
-/* Clones a string.
- * @param src - The null-terminated source string.
- * @returns - A newly allocated clone of the 'src' string. */
-const char* _gid_strclone(const char* src)
+/* The smallest block that a GIDArena allocates, in bytes. */
+#define GID_ARENA_MIN_BLOCK_SIZE (4096)
+
+/* The largest block that a GIDArena allocates, in bytes, unless a single
+ * allocation needs more. Each block is twice the size of the previous one,
+ * up to this size. */
+#define GID_ARENA_MAX_BLOCK_SIZE (1048576)
+
+/* The alignment of each allocation from a GIDArena, in bytes. */
+#define GID_ARENA_ALIGNMENT (16)
+
+/* A block of memory from which a GIDArena allocates. The memory follows
+ * the header, at an offset of _GID_ARENA_HEADER_SIZE. */
+typedef struct GIDArenaBlock
 {
-  if(src == NULL)
-    return NULL;
-  size_t len = strlen(src) + 1;//+1 for null terminator
-  const char* ret = malloc(sizeof(char) * len);
-  memcpy((char*)ret, (char*)src, len);
+  /* Pointer to the next GIDArenaBlock, or NULL. */
+  struct GIDArenaBlock* next;
+
+  /* The number of bytes of memory in this block. */
+  size_t size;
+
+  /* The number of bytes that have been allocated from this block. */
+  size_t used;
+} GIDArenaBlock;
+
+/* The size of a GIDArenaBlock, rounded up to GID_ARENA_ALIGNMENT. */
+#define _GID_ARENA_HEADER_SIZE \
+  ((sizeof(GIDArenaBlock) + GID_ARENA_ALIGNMENT - 1) \
+    & ~(size_t)(GID_ARENA_ALIGNMENT - 1))
+
+/* Allocates memory by bumping a pointer through large blocks, so many small
+ * allocations that live equally long cost few calls to malloc, and are all
+ * freed at once. Zero-initialize a GIDArena to use it. */
+typedef struct GIDArena
+{
+  /* Pointer to the GIDArenaBlock that is allocated from, or NULL. */
+  GIDArenaBlock* first;
+
+  /* Pointer to the last GIDArenaBlock, or NULL. */
+  GIDArenaBlock* last;
+
+  /* The size of the next block to allocate, or zero for
+   * GID_ARENA_MIN_BLOCK_SIZE. */
+  size_t next_block_size;
+} GIDArena;
+
+/* Allocates memory from a GIDArena.
+ * @param arena - Pointer to the GIDArena.
+ * @param size - The number of bytes to allocate.
+ * @returns - Pointer to the memory, aligned to GID_ARENA_ALIGNMENT, which
+ *          stays valid until the arena is freed or reset. */
+void* _gid_arena_alloc(GIDArena* arena, size_t size)
+{
+  size = (size + GID_ARENA_ALIGNMENT - 1) & ~(size_t)(GID_ARENA_ALIGNMENT - 1);
+  GIDArenaBlock* block = arena->first;
+  if(block == NULL || block->size - block->used < size)
+  {
+    size_t blockSize = arena->next_block_size;
+    if(blockSize < GID_ARENA_MIN_BLOCK_SIZE)
+      blockSize = GID_ARENA_MIN_BLOCK_SIZE;
+    arena->next_block_size = blockSize < GID_ARENA_MAX_BLOCK_SIZE
+      ? blockSize * 2
+      : GID_ARENA_MAX_BLOCK_SIZE;
+    if(blockSize < size)
+      blockSize = size;
+
+    block = malloc(_GID_ARENA_HEADER_SIZE + blockSize);
+    block->next = arena->first;
+    block->size = blockSize;
+    block->used = 0;
+    arena->first = block;
+    if(arena->last == NULL)
+      arena->last = block;
+  }
+  void* ret = (uint8_t*)block + _GID_ARENA_HEADER_SIZE + block->used;
+  block->used += size;
   return ret;
 }
 
+/* Frees all of the memory of a GIDArena except its newest block, which is
+ * kept for the next allocations.
+ * @param arena - Pointer to the GIDArena. */
+void _gid_reset_arena(GIDArena* arena)
+{
+  if(arena->first == NULL)
+    return;
+  GIDArenaBlock* block = arena->first->next;
+  while(block != NULL)
+  {
+    GIDArenaBlock* next = block->next;
+    free(block);
+    block = next;
+  }
+  arena->first->next = NULL;
+  arena->first->used = 0;
+  arena->last = arena->first;
+}
+
+/* Frees all of the memory of a GIDArena.
+ * @param arena - Pointer to the GIDArena, which will be empty. */
+void _gid_free_arena(GIDArena* arena)
+{
+  GIDArenaBlock* block = arena->first;
+  while(block != NULL)
+  {
+    GIDArenaBlock* next = block->next;
+    free(block);
+    block = next;
+  }
+  memset(arena, 0, sizeof(GIDArena));
+}
+
+/* Contains the strings that have been interned (see _gid_intern_string). */
+typedef struct GIDStringTable
+{
+  /* The interned strings, in an open-addressing hash table whose empty
+   * entries are NULL. */
+  const char** entries;
+
+  /* The number of entries in 'entries', which is a power of two. */
+  size_t capacity;
+
+  /* The number of strings in the table. */
+  size_t count;
+
+  /* The memory of the strings. */
+  GIDArena arena;
+} GIDStringTable;
+
+/* The interned strings, which are freed by _gid_free. This is only used by
+ * the thread that called gidunit(). */
+GIDStringTable _gid_interned_strings;
+
+/* The hash of no chars, which starts every hash (see _gid_hash_chars). */
+#define _GID_HASH_BASIS UINT64_C(0xCBF29CE484222325)
+
+/* Adds the chars of a string to a running 64-bit FNV-1a hash.
+ * @param hash - The hash so far, which is _GID_HASH_BASIS for the first
+ *        chars.
+ * @param str - The chars, which don't need a null terminator.
+ * @param len - The number of chars.
+ * @returns - The new hash. */
+uint64_t _gid_hash_chars(uint64_t hash, const char* str, size_t len)
+{
+  for(size_t i = 0; i < len; i++)
+  {
+    hash ^= (unsigned char)str[i];
+    hash *= UINT64_C(0x100000001B3);
+  }
+  return hash;
+}
+
+/* Interns a string, so each distinct string is stored only once, no matter
+ * how many times it is interned.
+ * @param str - The chars of the string, which don't need a null terminator.
+ * @param len - The number of chars.
+ * @returns - The null-terminated interned string, which stays valid until
+ *          _gid_free is called. */
+const char* _gid_intern_string(const char* str, size_t len)
+{
+  GIDStringTable* table = &_gid_interned_strings;
+  if((table->count + 1) * 2 > table->capacity)
+  {
+    //Grow the table, so it is never more than half full
+    size_t capacity = table->capacity == 0 ? 64 : table->capacity * 2;
+    const char** entries = calloc(capacity, sizeof(const char*));
+    for(size_t i = 0; i < table->capacity; i++)
+    {
+      const char* entry = table->entries[i];
+      if(entry == NULL)
+        continue;
+      uint64_t hash = _gid_hash_chars(_GID_HASH_BASIS, entry, strlen(entry));
+      size_t pos = hash & (capacity - 1);
+      while(entries[pos] != NULL)
+        pos = (pos + 1) & (capacity - 1);
+      entries[pos] = entry;
+    }
+    free((void*)table->entries);
+    table->entries = entries;
+    table->capacity = capacity;
+  }
+
+  uint64_t hash = _gid_hash_chars(_GID_HASH_BASIS, str, len);
+  size_t pos = hash & (table->capacity - 1);
+  while(table->entries[pos] != NULL)
+  {
+    const char* entry = table->entries[pos];
+    if(strncmp(entry, str, len) == 0 && entry[len] == '\0')
+      return entry;
+    pos = (pos + 1) & (table->capacity - 1);
+  }
+  char* interned = _gid_arena_alloc(&table->arena, len + 1);
+  memcpy(interned, str, len);
+  interned[len] = '\0';
+  table->entries[pos] = interned;
+  table->count++;
+  return interned;
+}
+
+/* Frees the interned strings. */
+void _gid_free_interned_strings()
+{
+  free((void*)_gid_interned_strings.entries);
+  _gid_free_arena(&_gid_interned_strings.arena);
+  memset(&_gid_interned_strings, 0, sizeof(GIDStringTable));
+}
+
+/* The GIDArena from which the test suites, tests and parameters are
+ * allocated when they are registered. They all live until _gid_free is
+ * called, which frees them at once. */
+GIDArena _gid_registration_arena;
+
+/* Holds the value of a test parameter. Every kind of parameter value fits
+ * in one of these members, so the values of all parameters of a test can be
+ * stored in one array. */
+typedef union GIDParamValue
+{
+  /* The value of a signed integer parameter. */
+  int64_t i;
+
+  /* The value of an unsigned integer parameter. */
+  uint64_t u;
+
+  /* The value of a string parameter, or the columns of a row parameter. */
+  const void* p;
+} GIDParamValue;
+
 /* Base structure for a test parameter. Each test can have multiple parameters,
  * and each test will run with all combinations of parameter values. Parameter
  * values are abstractly defined in this structure, and concretely defined in
- * various structures that will be stored in the 'data' field. */
+ * various structures that will be stored in the 'data' field. A parameter
+ * doesn't store which of its values is selected, since multiple
+ * configurations of a test may run at the same time. Instead, each value is
+ * identified by its zero-based position. */
 typedef struct GIDParamBase
 {
   /* Stores the implementation-specific data for the parameter, such as the set
-   * of possible values and the current value. */
+   * of possible values. */
   void* data;
 
   /* The name of the parameter. */
   const char* name;
 
+  /* The index of the slot that holds the value and position of this
+   * parameter in each test run, assigned when the parameter is added to a
+   * test. Parameters are read from their slots in the same order that they
+   * were added, so reading a parameter doesn't require looking it up by
+   * name. */
+  size_t slot;
+
   /* Pointer to a function that counts the number of stored values. The 'data'
    * field in this GIDParamBase structure will be passed as the only
    * argument. The function returns the number of values. */
   size_t (*value_count)(const void* data);
 
-  /* Pointer to a function that gets a pointer to the current value.
-   * The 'data' field of this GIDParamBase structure will be passed as the
-   * only argument. The function returns a pointer to the current value. */
-  void* (*current_value)(const void* data);
+  /* Pointer to a function that gets the value at a specific position. The
+   * 'data' field in this GIDParamBase structure will be passed as the first
+   * argument, the zero-based position of the value as the second argument,
+   * and the GIDParamValue into which the value will be written as the third
+   * argument. */
+  void (*get_value)(const void* data, size_t position, GIDParamValue* dst);
 
   /* Pointer to a function that generates a string representation of the
-   * current value. The 'data' field in this GIDParamBase structure will be
-   * passed as the first argument. The second argument is the destination
-   * buffer into which the string will be written (it may be NULL for
-   * counting the length of the string), and the third argument is the size
-   * of the destination buffer. The function returns the size of the string
-   * regardless of how many characters could fit in the destination buffer. */
-  size_t (*current_value_string)(const void* data, char* dst, size_t dstSize);
-
-  /* Pointer to a function that changes the value of this parameter to the 'next
-   * value', if possible. The 'data' field in this GIDParamBase structure will
-   * be the only argment, and the function returns non-zero if there was a 'next
-   * value', otherwise zero. */
-  int (*next_value)(void* data);
-
-  /* Pointer to a function that resets the value of this parameter to the
-   * initial value. The 'data' field in this GIDParamBase structure will be
-   * the only argument, and the function does not have a return value. */
-  void (*reset_value)(void* data);
-
-  /* Pointer to a function that frees any memory that was allocated by the
-   * implementation. The 'data' parameter in this GIDParamBase structure will
-   * be the only argument, and the implementation is required to free it. */
-  void (*free_data)(void* data);
+   * value at a specific position. The 'data' field in this GIDParamBase
+   * structure will be passed as the first argument, and the zero-based
+   * position of the value as the second argument. The third argument is the
+   * destination buffer into which the string will be written (it may be NULL
+   * for counting the length of the string), and the fourth argument is the
+   * size of the destination buffer. The function returns the size of the
+   * string regardless of how many characters could fit in the destination
+   * buffer. */
+  size_t (*get_value_string)(
+    const void* data,
+    size_t position,
+    char* dst,
+    size_t dstSize);
+
+  /* Does the parameter have too many values to count in a size_t (such as a
+   * range of every 64-bit integer)? Non-zero means yes, and the test it is
+   * added to can't be run (see _gid_fail_config_overflow). */
+  int has_value_overflow;
 
   /* Pointer to the next linked parameter, or NULL. */
   struct GIDParamBase* next;
@@ -254,52 +555,52 @@ size_t _gid_param_value_count(const GIDParamBase* param)
   return param->value_count(param->data);
 }
 
-/* Gets the current value of a parameter.
+/* Gets the value at a specific position of a parameter.
  * @param param - Pointer to the GIDParamBase from which to get the value.
- * @returns - Pointer to the value. */
-void* _gid_param_get_value(const GIDParamBase* param)
+ * @param position - The zero-based position of the value. Must be less than
+ *        the number of values in the parameter.
+ * @param dst - Pointer to the GIDParamValue that will receive the value. */
+void _gid_param_get_value(
+  const GIDParamBase* param,
+  size_t position,
+  GIDParamValue* dst)
 {
-  return param->current_value(param->data);
+  param->get_value(param->data, position, dst);
 }
 
-/* Generates a string representation of the current value of a parameter.
+/* Generates a string representation of the value at a specific position of
+ * a parameter.
  * @param param - Pointer to the GIDParamBase from which to get the value
  *        string.
+ * @param position - The zero-based position of the value.
  * @param dst - Destination buffer, may be NULL to count the length of the
  *        string.
  * @param dstSize - The size of the destination buffer.
  * @returns - The size of the value string, regardless of how many bytes
  *            could fit in the dst buffer, excluding the null terminator. */
-size_t _gid_param_get_value_string(const GIDParamBase* param, char* dst, size_t dstSize)
-{
-  return param->current_value_string(param->data, dst, dstSize);
-}
-
-/* Changes the value of a parameter to the 'next value', if any.
- * @param param - Pointer to the GIDParamBase on which to change
- *        the value.
- * @returns - Non-zero if the value was changed. Zero means that
- *            there are no more values. */
-int _gid_param_next_value(GIDParamBase* param)
-{
-  return param->next_value(param->data);
-}
-
-/* Resets a parameter to its initial value.
- * @param param - Pointer to the GIDParamBase on which to reset the value. */
-void _gid_param_reset_value(GIDParamBase* param)
+size_t _gid_param_get_value_string(
+  const GIDParamBase* param,
+  size_t position,
+  char* dst,
+  size_t dstSize)
 {
-  param->reset_value(param->data);
+  return param->get_value_string(param->data, position, dst, dstSize);
 }
 
 /* Gets a string representation of a linked list of parameters.
  * @param root - The root GIDParamBase to stringify. All GIDParamBases
  *        that are linked to this root will be stringified.
+ * @param positions - The position of the value of each parameter, indexed
+ *        by the 'slot' of the parameter's GIDParamBase.
  * @param dst - The destination buffer.
  * @param dstSize - The size of the destination buffer.
  * @returns - The total size of the required string, regardless of how
  * many bytes were actually written to the destination buffer. */
-int64_t _gid_get_params_string(GIDParamBase* root, char* dst, int64_t dstSize)
+int64_t _gid_get_params_string(
+  const GIDParamBase* root,
+  const size_t* positions,
+  char* dst,
+  int64_t dstSize)
 {
   int64_t pos = 0;
   int first = 1;
@@ -310,7 +611,8 @@ int64_t _gid_get_params_string(GIDParamBase* root, char* dst, int64_t dstSize)
       root = root->next;
       continue;//Don't print params with no values
     }
-    int64_t valueLen = _gid_param_get_value_string(root, NULL, 0);
+    size_t position = positions[root->slot];
+    int64_t valueLen = _gid_param_get_value_string(root, position, NULL, 0);
 
     if(!first)
     {
@@ -335,7 +637,7 @@ int64_t _gid_get_params_string(GIDParamBase* root, char* dst, int64_t dstSize)
     pos++;
 
     if(dst != NULL && dstSize > pos)
-      _gid_param_get_value_string(root, dst+pos, dstSize-pos);
+      _gid_param_get_value_string(root, position, dst+pos, dstSize-pos);
     pos += valueLen;
 
     if(root->next != NULL)
@@ -352,29 +654,6 @@ int64_t _gid_get_params_string(GIDParamBase* root, char* dst, int64_t dstSize)
   return pos;
 }
 
-/* Frees memory that was allocated for a parameter.
- * @param param - Pointer to the parameter's GIDParamBase. */
-void _gid_param_free(GIDParamBase* param)
-{
-  param->free_data(param->data);
-  free((char*)param->name);
-  free(param);
-}
-
-/* Frees all memory in a linked list of parameters.
- * @param root - Pointer to the first GIDParamBase in the linked list of
- *        parameters to free. */
-void _gid_free_params(GIDParamBase* root)
-{
-  GIDParamBase* cur = root;
-  while(cur != NULL)
-  {
-    GIDParamBase* next = cur->next;
-    _gid_param_free(cur);
-    cur = next;
-  }
-}
-
 /* Defines the type of data stored in a GIDRowParam. */
 typedef enum GIDRowParamType
 {
@@ -388,71 +667,40 @@ typedef enum GIDRowParamType
   GID_ROW_PARAM_TYPE_STRING,
 } GIDRowParamType;
 
+/* The number of zeroed columns that are kept after each row of a row
+ * parameter, just in case a test accidentally goes out of bounds. */
+#define GID_ROW_PARAM_PADDING_COLS (32)
+
 /* Contains the value of one row in a GIDRowParam.
  * A single value consists of multiple columns. */
 typedef struct GIDRowParamValue
 {
-  /* Pointer to the memory of the values in the columns. */
-  void* cols;
+  /* Pointer to the values in the columns, which are followed by
+   * GID_ROW_PARAM_PADDING_COLS zeroed columns. */
+  const void* cols;
 
   /* The number of stored columns. */
   size_t col_count;
-
-  /* Pointer to the next linked GIDRowParamValue, or NULL if none. */
-  struct GIDRowParamValue* next_row;
 } GIDRowParamValue;
 
-/* Creates a GIDRowParamValue in memory.
- * @param cols - Pointer to the values to store in the columns. This data
- *        will be copied.
- * @param valueSize - The size, in bytes, of each column value.
- * @param colCount - The number of columns.
- * @param type - The GIDRowParamType that defines the type of data that is
- *        stored in each column.
- * @returns - A pointer to the allocated GIDRowParamValue. */
-GIDRowParamValue* _gid_create_row_param_value(
-  const void* cols,
-  size_t valueSize,
-  size_t colCount,
-  GIDRowParamType type)
-{
-  GIDRowParamValue* ret = malloc(sizeof(GIDRowParamValue));
-  /* Add padding just in case a test accidentally goes out of bounds */
-  size_t paddingColCount = 32;
-  ret->cols = malloc((colCount + paddingColCount) * valueSize);
-
-  if(type != GID_ROW_PARAM_TYPE_STRING)
-  {
-    memcpy((void*)ret->cols, cols, colCount * valueSize);
-  }
-  else
-  {
-    /*Copy the string values, not just the pointers*/
-    for(size_t i = 0; i < colCount; i++)
-      ((char**)ret->cols)[i] = (char*)_gid_strclone(((const char**)cols)[i]);
-  }
-
-  memset((uint8_t*)ret->cols+(colCount*valueSize), 0, paddingColCount * valueSize);
-  ret->col_count = colCount;
-  ret->next_row = NULL;
-  return ret;
-}
-
 /* Contains data for a 'row parameter', which is a parameter that stores
- * multiple rows (defined by the test) each with multiple columns of values. */
+ * multiple rows (defined by the test) each with multiple columns of values.
+ * The rows are stored in one array, and their columns are allocated from the
+ * registration arena one row after the other, so they are adjacent in
+ * memory. */
 typedef struct GIDRowParamData
 {
-  /* Pointer to the first GIDRowParamValue that is defined for the test that
-   * contains this row parameter, or NULL if none. */
-  GIDRowParamValue* first_row;
+  /* The rows, or NULL if none. */
+  GIDRowParamValue* rows;
+
+  /* The number of rows. */
+  size_t row_count;
 
-  /* Pointer to the last GIDRowParamValue that is defined for the test that
-   * contains this row parameter, or NULL if none. */
-  GIDRowParamValue* last_row;
+  /* The number of elements allocated for the 'rows' array. */
+  size_t row_capacity;
 
-  /* Pointer to the GIDRowParamValue that contains the columns that are
-   * currently selected for this row parameter, or NULL if none. */
-  GIDRowParamValue* current_row;
+  /* The size, in bytes, of each column value. */
+  size_t value_size;
 
   /* The GIDRowParamType that defines the type of data stored in each column. */
   GIDRowParamType type;
@@ -465,34 +713,50 @@ typedef struct GIDRowParamData
 size_t _gid_row_param_value_count(const void* data)
 {
   const GIDRowParamData* rowData = data;
-  size_t count = 0;
-  GIDRowParamValue* value = rowData->first_row;
-  while(value != NULL)
-  {
-    count++;
-    value = value->next_row;
-  }
-  return count;
+  return rowData->row_count;
 }
 
-/* Gets the current row value of a 'row parameter'.
+/* Gets the row at a specific position of a 'row parameter'.
  * @param data - Pointer to the GIDRowParamData.
- * @returns - Pointer to the GIDRowParamValue, or NULL if the row parameter
- *          is empty. */
-void* _gid_row_param_get_current_value(const void* data)
+ * @param position - The zero-based position of the row.
+ * @returns - Pointer to the GIDRowParamValue, or NULL if there is no row
+ *          at the position (such as when the row parameter is empty). */
+const GIDRowParamValue* _gid_row_param_get_row(
+  const void* data,
+  size_t position)
 {
   const GIDRowParamData* rowData = data;
-  return rowData->current_row;
+  if(position < rowData->row_count)
+    return &rowData->rows[position];
+  else
+    return NULL;
+}
+
+/* Gets the value at a specific position of a 'row parameter', which is a
+ * pointer to the columns of the row.
+ * @param data - Pointer to the GIDRowParamData.
+ * @param position - The zero-based position of the row.
+ * @param dst - Pointer to the GIDParamValue that will receive the pointer to
+ *        the columns, or NULL if the row parameter is empty. */
+void _gid_row_param_get_value(
+  const void* data,
+  size_t position,
+  GIDParamValue* dst)
+{
+  const GIDRowParamValue* row = _gid_row_param_get_row(data, position);
+  dst->p = row != NULL ? row->cols : NULL;
 }
 
-/* Gets a string representation of a 'row parameter'.
+/* Gets a string representation of a row of a 'row parameter'.
  * @param data - Pointer to the GIDRowParamData.
+ * @param position - The zero-based position of the row.
  * @param dst - The destination buffer.
  * @param dstSize - The size of the destination buffer.
  * @returns - The actual size of the string, regardless of how much could
  *          fit in the destination buffer. */
-size_t _gid_row_param_get_current_value_string(
+size_t _gid_row_param_get_value_string(
   const void* data,
+  size_t position,
   char* dst,
   size_t dstSize)
 {
@@ -503,7 +767,7 @@ size_t _gid_row_param_get_current_value_string(
     dst[pos] = '{';
   pos++;
 
-  GIDRowParamValue* row = rowData->current_row;
+  const GIDRowParamValue* row = _gid_row_param_get_row(data, position);
   if(row != NULL)
   {
     for(size_t i = 0; i < row->col_count; i++)
@@ -518,13 +782,13 @@ size_t _gid_row_param_get_current_value_string(
       switch(rowData->type)
       {
         case GID_ROW_PARAM_TYPE_INT64:
-          pos += snprintf(dst != NULL ? dst+pos : NULL, dstSize > pos ? dstSize - pos : 0, "%"PRId64, ((int64_t*)row->cols)[i]);
+          pos += snprintf(dst != NULL ? dst+pos : NULL, dstSize > pos ? dstSize - pos : 0, "%"PRId64, ((const int64_t*)row->cols)[i]);
           break;
         case GID_ROW_PARAM_TYPE_UINT64:
-          pos += snprintf(dst != NULL ? dst+pos : NULL, dstSize > pos ? dstSize - pos : 0, "%"PRIu64, ((uint64_t*)row->cols)[i]);
+          pos += snprintf(dst != NULL ? dst+pos : NULL, dstSize > pos ? dstSize - pos : 0, "%"PRIu64, ((const uint64_t*)row->cols)[i]);
           break;
         case GID_ROW_PARAM_TYPE_STRING:
-          pos += snprintf(dst != NULL ? dst+pos : NULL, dstSize > pos ? dstSize - pos : 0, "%s", ((char**)row->cols)[i]);
+          pos += snprintf(dst != NULL ? dst+pos : NULL, dstSize > pos ? dstSize - pos : 0, "%s", ((const char**)row->cols)[i]);
           break;
         default:
           if(pos + 1 < dstSize && dst != NULL)
@@ -567,107 +831,78 @@ size_t _gid_row_param_get_current_value_string(
   return pos;
 }
 
-/* Moves the 'current value' of a 'row parameter' to the next row, if any.
- * @param data - Pointer to the GIDRowParamData.
- * @returns - True if there was a 'next row', otherwise false. */
-int _gid_row_param_next_value(void* data)
-{
-  GIDRowParamData* rowData = data;
-  if(rowData->current_row != NULL)
-  {
-    if(rowData->current_row->next_row != NULL)
-    {
-      rowData->current_row = rowData->current_row->next_row;
-      return 1;
-    }
-    else
-    {
-      //At last row
-      return 0;
-    }
-  }
-  else
-  {
-    //No values
-    return 0;
-  }
-}
-
-/* Resets the 'current value' of a 'row parameter' to the first
- * stored row, if any.
- * @param data - Pointer to the GIDRowParamData. */
-void _gid_row_param_reset_value(void* data)
-{
-  GIDRowParamData* rowData = data;
-  rowData->current_row = rowData->first_row;
-}
-
-/* Frees memory allocated for a row parameter.
- * @param data - Pointer to the GIDRowParamData to free. */
-void _gid_row_param_free_data(void* data)
-{
-  GIDRowParamData* rowData = data;
-  GIDRowParamValue* value = rowData->first_row;
-  while(value != NULL)
-  {
-    GIDRowParamValue* next = value->next_row;
-    if(rowData->type == GID_ROW_PARAM_TYPE_STRING)
-    {
-      //Free all strings from memory
-      for(size_t i = 0; i < value->col_count; i++)
-        free(((char**)value->cols)[i]);
-    }
-
-    free((void*)value->cols);
-    free(value);
-    value = next;
-  }
-  free(data);
-}
-
-/* Creates a row parameter.
- * @param name - The name of the parameter.
+/* Creates a row parameter in the registration arena.
+ * @param name - The name of the parameter. This isn't copied, so it must be
+ *        a string literal.
  * @param type - The GIDRowParamType that defines the type of data stored in
  *        each column.
  * @returns - Pointer to the GIDParamBase for the newly allocated row
  *          parameter. */
 GIDParamBase* _gid_create_row_param(const char* name, GIDRowParamType type)
 {
-  GIDRowParamData* data = malloc(sizeof(GIDRowParamData));
-  data->first_row = NULL;
-  data->last_row = NULL;
-  data->current_row = NULL;
+  GIDArena* arena = &_gid_registration_arena;
+  GIDRowParamData* data = _gid_arena_alloc(arena, sizeof(GIDRowParamData));
+  data->rows = NULL;
+  data->row_count = 0;
+  data->row_capacity = 0;
+  data->value_size = type == GID_ROW_PARAM_TYPE_STRING
+    ? sizeof(char*)
+    : sizeof(uint64_t);
   data->type = type;
 
-  GIDParamBase* base = malloc(sizeof(GIDParamBase));
+  GIDParamBase* base = _gid_arena_alloc(arena, sizeof(GIDParamBase));
   base->data = data;
-  base->name = _gid_strclone(name);
+  base->name = name;
   base->value_count = _gid_row_param_value_count;
-  base->current_value = _gid_row_param_get_current_value;
-  base->current_value_string = _gid_row_param_get_current_value_string;
-  base->next_value = _gid_row_param_next_value;
-  base->reset_value = _gid_row_param_reset_value;
-  base->free_data = _gid_row_param_free_data;
+  base->get_value = _gid_row_param_get_value;
+  base->get_value_string = _gid_row_param_get_value_string;
+  base->slot = 0;
+  base->has_value_overflow = 0;
   base->next = NULL;
   return base;
 }
 
-/* Adds a row to a row parameter.
+/* Adds a row to a row parameter. The array of rows grows by doubling in the
+ * registration arena, where the old arrays are left, so adding rows takes
+ * linear time.
  * @param param - Pointer to the GIDParamBase of the destination row
  *        parameter.
- * @param value - Pointer to the GIDRowParamValue to add. */
-void _gid_add_row_param_value(GIDParamBase* param, GIDRowParamValue* value)
+ * @param cols - Pointer to the values of the columns, each of which is the
+ *        'value_size' of the row parameter. The values are copied, but
+ *        strings are not, so they must be string literals.
+ * @param colCount - The number of columns. */
+void _gid_add_row_param_value(
+  GIDParamBase* param,
+  const void* cols,
+  size_t colCount)
 {
   GIDRowParamData* data = param->data;
-  GIDRowParamValue* prev = data->last_row;
-  data->last_row = value;
-  if(data->first_row == NULL)
+  GIDArena* arena = &_gid_registration_arena;
+
+  if(data->row_count == data->row_capacity)
   {
-    data->first_row = value;
-    data->current_row = value;
+    data->row_capacity = data->row_capacity > 0 ? data->row_capacity * 2 : 8;
+    GIDRowParamValue* rows = _gid_arena_alloc(
+      arena,
+      sizeof(GIDRowParamValue) * data->row_capacity);
+    if(data->row_count > 0)
+      memcpy(rows, data->rows, sizeof(GIDRowParamValue) * data->row_count);
+    data->rows = rows;
   }
-  if(prev != NULL)
-    prev->next_row = value;
+
+  uint8_t* rowCols = _gid_arena_alloc(
+    arena,
+    (colCount + GID_ROW_PARAM_PADDING_COLS) * data->value_size);
+  memcpy(rowCols, cols, colCount * data->value_size);
+  memset(
+    rowCols + colCount * data->value_size,
+    0,
+    GID_ROW_PARAM_PADDING_COLS * data->value_size);
+
+  GIDRowParamValue* row = &data->rows[data->row_count];
+  row->cols = rowCols;
+  row->col_count = colCount;
+  data->row_count++;
 }
 
 /* Contains data for a 'range parameter', which is a parameter that contains
@@ -682,88 +917,73 @@ typedef struct GIDRangeParamData
   /* The maximum value. */
   const int64_t max;
 
-  /* The current value. */
-  int64_t current;
-
   /* Does the test want to treat the values in this parameter as though they
    * are signed? Non-zero means yes, the values are interpreted as signed. Zero
    * means that the values are interpreted as unsigned integers. */
   int is_signed;
 } GIDRangeParamData;
 
+/* Gets the distance from the minimum to the maximum value of a range
+ * parameter, which is one less than its number of values. The distance is
+ * computed in unsigned arithmetic, so it is right for signed ranges too.
+ * @param rangeData - Pointer to the GIDRangeParamData.
+ * @returns - The distance. */
+uint64_t _gid_range_param_span(const GIDRangeParamData* rangeData)
+{
+  return (uint64_t)rangeData->max - (uint64_t)rangeData->min;
+}
+
 /* Gets the number of values in a range parameter.
  * @param data - Pointer to the GIDRangeParamData.
- * @returns - The number of values. */
+ * @returns - The number of values, or SIZE_MAX if there are too many to
+ *          count (see the 'has_value_overflow' field of GIDParamBase). */
 size_t _gid_range_param_value_count(const void* data)
 {
-  const GIDRangeParamData* rangeData = data;
-  if(rangeData->is_signed)
-    return (rangeData->max - rangeData->min) + 1;
-  else
-    return ((uint64_t)rangeData->max - (uint64_t)rangeData->min) + 1;
+  uint64_t span = _gid_range_param_span(data);
+  if(span >= SIZE_MAX)
+    return SIZE_MAX;
+  return (size_t)span + 1;
 }
 
-/* Gets the current value in a range parameter.
+/* Gets the value at a specific position in a range parameter.
  * @param data - Pointer to the GIDRangeParamData.
- * @returns - Pointer to the value. */
-void* _gid_range_param_get_current_value(const void* data)
+ * @param position - The zero-based position of the value, which is its
+ *        distance from the minimum value.
+ * @param dst - Pointer to the GIDParamValue that will receive the value. */
+void _gid_range_param_get_value(
+  const void* data,
+  size_t position,
+  GIDParamValue* dst)
 {
   const GIDRangeParamData* rangeData = data;
-  return (void*)&rangeData->current;
+  dst->u = (uint64_t)rangeData->min + position;
 }
 
-/* Gets a string representation of the current value in a range parameter.
+/* Gets a string representation of the value at a specific position in a range
+ * parameter.
  * @param data - Pointer to the GIDRangeParamData.
+ * @param position - The zero-based position of the value.
  * @param dst - The destination buffer.
  * @param dstSize - The size of the destination buffer.
  * @returns - The size of the string representation, regardless of how many
  *          characters were written to the destination buffer.*/
-size_t _gid_range_param_get_current_value_string(
+size_t _gid_range_param_get_value_string(
   const void* data,
+  size_t position,
   char* dst,
   size_t dstSize)
 {
   const GIDRangeParamData* rangeData = data;
-  const char* format = rangeData->is_signed ? "%"PRId64 : ""PRIu64;
-  return snprintf(dst, dstSize, format, rangeData->current);
-}
-
-/* Increments the 'current value' of a range parameter, if it is below
- * the maximum value.
- * @param data - Pointer to the GIDRangeParamData.
- * @returns - Non-zero if the value was incremented. Zero means that the
- *            maximum value is already selected, thus it cannot increment. */
-int _gid_range_param_next_value(void* data)
-{
-  GIDRangeParamData* rangeData = data;
-  if((rangeData->is_signed && rangeData->current < rangeData->max) || (!rangeData->is_signed && (uint64_t)rangeData->current < (uint64_t)rangeData->max))
-  {
-    rangeData->current++;
-    return 1;
-  }
-  else
-  {
-    return 0;
-  }
-}
-
-/* Resets the 'current value' of a range parameter to its minimum.
- * @param data - Pointer to the GIDRangeParamData. */
-void _gid_range_param_reset_value(void* data)
-{
-  GIDRangeParamData* rangeData = data;
-  rangeData->current = rangeData->min;
-}
-
-/* Frees a GIDRangeParamData and all of its associated memory.
- * @param data - Pointer to the GIDRangeParamData. */
-void _gid_range_param_free_data(void* data)
-{
-  free(data);
+  GIDParamValue value;
+  _gid_range_param_get_value(data, position, &value);
+  if(rangeData->is_signed)
+    return snprintf(dst, dstSize, "%"PRId64, value.i);
+  return snprintf(dst, dstSize, "%"PRIu64, value.u);
 }
 
-/* Creates a range parameter.
- * @param name - The name of the variable.
+/* Creates a range parameter in the registration arena.
+ * @param name - The name of the variable. This isn't copied, so it must be
+ *        a string literal.
  * @param min - The minimum value of the parameter.
  * @param max - The maximum value of the parameter.
  * @param isSigned - Should the parameter's value be signed? If false (0), then
@@ -771,21 +991,21 @@ void _gid_range_param_free_data(void* data)
  * @returns - Pointer to the GIDParamBase of the range parameter. */
 GIDParamBase* _gid_create_range_param(const char* name, int64_t min, int64_t max, int isSigned)
 {
-  GIDRangeParamData* data = malloc(sizeof(GIDRangeParamData));
+  GIDArena* arena = &_gid_registration_arena;
+  GIDRangeParamData* data =
+    _gid_arena_alloc(arena, sizeof(GIDRangeParamData));
   memcpy((int64_t*)&data->min, &min, sizeof(data->min));
-  memcpy((int64_t*)&data->current, &min, sizeof(data->current));
   memcpy((int64_t*)&data->max, &max, sizeof(data->max));
   data->is_signed = isSigned;
 
-  GIDParamBase* base = malloc(sizeof(GIDParamBase));
+  GIDParamBase* base = _gid_arena_alloc(arena, sizeof(GIDParamBase));
   base->data = data;
-  base->name = _gid_strclone(name);
+  base->name = name;
   base->value_count = _gid_range_param_value_count;
-  base->current_value = _gid_range_param_get_current_value;
-  base->current_value_string = _gid_range_param_get_current_value_string;
-  base->next_value = _gid_range_param_next_value;
-  base->reset_value = _gid_range_param_reset_value;
-  base->free_data = _gid_range_param_free_data;
+  base->get_value = _gid_range_param_get_value;
+  base->get_value_string = _gid_range_param_get_value_string;
+  base->slot = 0;
+  base->has_value_overflow = _gid_range_param_span(data) >= SIZE_MAX;
   base->next = NULL;
   return base;
 }
@@ -818,9 +1038,6 @@ typedef struct GIDEnumParamData
 
   /* The number of values defined by the test. */
   size_t count;
-
-  /* The zero-based index of the current value. */
-  size_t index;
 } GIDEnumParamData;
 
 /* Gets the number of values in an 'enum parameter'.
@@ -832,24 +1049,41 @@ size_t _gid_enum_param_value_count(const void* data)
   return paramData->count;
 }
 
-/* Gets the current value of an 'enum parameter'.
+/* Gets the value at a specific position of an 'enum parameter'.
  * @param data - Pointer to the GIDEnumParamData.
- * @returns - Pointer to the current value. */
-void* _gid_enum_param_get_current_value(const void* data)
+ * @param position - The zero-based index of the value.
+ * @param dst - Pointer to the GIDParamValue that will receive the value. */
+void _gid_enum_param_get_value(
+  const void* data,
+  size_t position,
+  GIDParamValue* dst)
 {
   const GIDEnumParamData* paramData = data;
-  return ((uint8_t*)paramData->values)
-    + (paramData->value_size * paramData->index);
+  switch(paramData->type)
+  {
+    case GID_ENUM_PARAM_TYPE_INT64:
+      dst->i = ((int64_t*)paramData->values)[position];
+      break;
+    case GID_ENUM_PARAM_TYPE_UINT64:
+      dst->u = ((uint64_t*)paramData->values)[position];
+      break;
+    case GID_ENUM_PARAM_TYPE_STRING:
+      dst->p = ((char**)paramData->values)[position];
+      break;
+  }
 }
 
-/* Gets a string representation of the current value of an 'enum parameter.'
+/* Gets a string representation of the value at a specific position of an
+ * 'enum parameter.'
  * @param data - Pointer to the GIDEnumParamData.
+ * @param position - The zero-based index of the value.
  * @param dst - Destination buffer.
  * @param dstSize - The size of the destination buffer.
  * @returns - The total size of the string representation, regardless of how
  *          many characters were written to the destination buffer. */
-size_t _gid_enum_param_get_current_value_string(
+size_t _gid_enum_param_get_value_string(
   const void* data,
+  size_t position,
   char* dst,
   size_t dstSize)
 {
@@ -862,66 +1096,32 @@ size_t _gid_enum_param_get_current_value_string(
         dst,
         dstSize,
         "%"PRIi64,
-        ((int64_t*)paramData->values)[paramData->index]);
+        ((int64_t*)paramData->values)[position]);
     case GID_ENUM_PARAM_TYPE_UINT64:
       return snprintf(
         dst,
         dstSize,
         "%"PRIu64,
-        ((uint64_t*)paramData->values)[paramData->index]);
+        ((uint64_t*)paramData->values)[position]);
     case GID_ENUM_PARAM_TYPE_STRING:
       return snprintf(
         dst,
         dstSize,
         "\"%s\"",
-        ((char**)paramData->values)[paramData->index]);
+        ((char**)paramData->values)[position]);
     default:
       strncpy(dst, fallback, dstSize);
       return strlen(fallback);
   }
 }
 
-/* Moves the value of an 'enum parameter' to the next value that was defined
- * by the test, if any.
- * @param data - Pointer to the GIDEnumParamData.
- * @returns - Non-zero if a 'next value' was selected. Zero means that there
- *          are no more 'next' values. */
-int _gid_enum_param_next_value(void* data)
-{
-  GIDEnumParamData* paramData = data;
-  if(paramData->index + 1 < paramData->count)
-  {
-    paramData->index++;
-    return 1;
-  }
-  else
-  {
-    return 0;
-  }
-}
-
-/* Resets an 'enum parameter' to the first value defined by the test.
- * @param data - Pointer to the GIDEnumParamData. */
-void _gid_enum_param_reset_value(void* data)
-{
-  GIDEnumParamData* paramData = data;
-  paramData->index = 0;
-}
-
-/* Frees memory allocated for an 'enum parameter'.
- * @param data - Pointer to the GIDEnumParamData. */
-void _gid_enum_param_free_data(void* data)
-{
-  const GIDEnumParamData* paramData = data;
-  free(paramData->values);
-  free(data);
-}
-
-/* Creates an 'enum parameter'.
- * @param name - The name of the parameter.
+/* Creates an 'enum parameter' in the registration arena.
+ * @param name - The name of the parameter. This isn't copied, so it must be
+ *        a string literal.
  * @param type - The GIDEnumParamType that defines the type of values that
  *        will be stored in the parameter.
- * @param values - Pointer to the array of values. These values will be copied.
+ * @param values - Pointer to the array of values. These values will be copied,
+ *        but strings are not, so they must be string literals.
  * @param valueSize - The size of each value.
  * @param valueCount - The number of values.
  * @returns - Pointer to the GIDParamBase for the allocated enum parameter. */
@@ -932,23 +1132,23 @@ GIDParamBase* _gid_create_enum_param(
   size_t valueSize,
   size_t valueCount)
 {
-  GIDEnumParamData* paramData = malloc(sizeof(GIDEnumParamData));
+  GIDArena* arena = &_gid_registration_arena;
+  GIDEnumParamData* paramData =
+    _gid_arena_alloc(arena, sizeof(GIDEnumParamData));
   paramData->type = type;
-  paramData->values = malloc(valueSize * valueCount);
+  paramData->values = _gid_arena_alloc(arena, valueSize * valueCount);
   memcpy(paramData->values, values, valueSize * valueCount);
   paramData->value_size = valueSize;
   paramData->count = valueCount;
-  paramData->index = 0;
 
-  GIDParamBase* base = malloc(sizeof(GIDParamBase));
+  GIDParamBase* base = _gid_arena_alloc(arena, sizeof(GIDParamBase));
   base->data = paramData;
-  base->name = _gid_strclone(name);
+  base->name = name;
   base->value_count = _gid_enum_param_value_count;
-  base->current_value = _gid_enum_param_get_current_value;
-  base->current_value_string = _gid_enum_param_get_current_value_string;
-  base->next_value = _gid_enum_param_next_value;
-  base->reset_value = _gid_enum_param_reset_value;
-  base->free_data = _gid_enum_param_free_data;
+  base->get_value = _gid_enum_param_get_value;
+  base->get_value_string = _gid_enum_param_get_value_string;
+  base->slot = 0;
+  base->has_value_overflow = 0;
   base->next = NULL;
   return base;
 }
@@ -986,20 +1186,29 @@ typedef enum GIDTestStep
   GID_STEP_TEARDOWN = 2,
 } GIDTestStep;
 
-/* Contains information about a test failure. */
+/* Contains information about a test failure. Failures are allocated from a
+ * GIDArena, together with their 'configuration' and 'message', and are freed
+ * with it. */
 typedef struct GIDTestFailure
 {
-  /* The name of the test that failed. */
+  /* The name of the test that failed, which is the 'name' of its GIDTest. */
   const char* test_name;
 
   /* The configuration of the test that resulted in this failure.
    * This is a string representation of all of the test's parameters. */
   const char* configuration;
 
+  /* The zero-based index of the configuration that resulted in this
+   * failure. Failures are ordered by this index, regardless of the order in
+   * which the configurations finished running. */
+  uint64_t configuration_index;
+
   /* A message that explains why the test failed. */
   const char* message;
 
-  /* The source file in which the failure was located. */
+  /* The source file in which the failure was located. This isn't copied,
+   * since it is a __FILE__ literal or an interned string (see
+   * _gid_intern_string). */
   const char* source_file;
 
   /* The line in the source file where the failure was detected. */
@@ -1014,115 +1223,996 @@ typedef struct GIDTestFailure
 
 } GIDTestFailure;
 
-/* Creates a GIDTestFailure.
- * @param testName - The name of the test that failed.
+/* Creates a GIDTestFailure. The failure and copies of its configuration and
+ * message are allocated from a GIDArena at once.
+ * @param arena - Pointer to the GIDArena from which to allocate.
+ * @param testName - The name of the test that failed. This isn't copied, so
+ *        it must remain valid for the life of the failure, such as the name
+ *        of the GIDTest.
  * @param config - The configuration of the test that resulted in the failure.
  *        This is a string representation of all of the test's parameters.
+ * @param configIndex - The zero-based index of the configuration.
  * @param message - Message that explains why the test failed.
- * @param srcFile - The source file in which the failure was detected.
+ * @param srcFile - The source file in which the failure was detected. This
+ *        isn't copied, so it must remain valid for the life of the failure,
+ *        such as __FILE__ or an interned string (see _gid_intern_string).
  * @param line - The line in the source file where the failure was detected.
  * @param step - The GIDTestStep that defines what step resulted in the failure.
  * @returns - A pointer to the allocated GIDTestFailure. */
 GIDTestFailure* _gid_create_test_failure(
+  GIDArena* arena,
   const char* testName,
   const char* config,
+  uint64_t configIndex,
   const char* message,
   const char* srcFile,
   int line,
   GIDTestStep step)
 {
-  GIDTestFailure* ret = malloc(sizeof(GIDTestFailure));
-  ret->test_name = _gid_strclone(testName);
-  ret->configuration = _gid_strclone(config);
-  ret->message = _gid_strclone(message);
-  ret->source_file = _gid_strclone(srcFile);
+  size_t configLen = strlen(config) + 1;
+  size_t messageLen = strlen(message) + 1;
+  GIDTestFailure* ret = _gid_arena_alloc(
+    arena,
+    sizeof(GIDTestFailure) + configLen + messageLen);
+  char* strings = (char*)(ret + 1);
+  memcpy(strings, config, configLen);
+  memcpy(strings + configLen, message, messageLen);
+  ret->test_name = testName;
+  ret->configuration = strings;
+  ret->configuration_index = configIndex;
+  ret->message = strings + configLen;
+  ret->source_file = srcFile;
   ret->line = line;
   ret->step = step;
   ret->next = NULL;
   return ret;
 }
 
-/* Frees a linked list of GIDTestFailures.
- * @param root - Pointer to the root GIDTestFailure to free. */
-void _gid_free_test_failures(GIDTestFailure* root)
+/* Sorts a linked list of GIDTestFailures by their configuration index.
+ * The sort is stable, so failures of the same configuration remain in the
+ * order that they occurred (such as a setup failure before a teardown
+ * failure).
+ * @param root - Pointer to the root GIDTestFailure of the list to sort.
+ * @returns - Pointer to the root GIDTestFailure of the sorted list. */
+GIDTestFailure* _gid_sort_test_failures(GIDTestFailure* root)
 {
-  while(root != NULL)
+  if(root == NULL || root->next == NULL)
+    return root;
+
+  //Split the list in half
+  GIDTestFailure* slow = root;
+  GIDTestFailure* fast = root->next;
+  while(fast != NULL && fast->next != NULL)
   {
-    GIDTestFailure* next = root->next;
-    free((char*)root->test_name);
-    free((char*)root->configuration);
-    free((char*)root->message);
-    free((char*)root->source_file);
-    free(root);
-    root = next;
+    slow = slow->next;
+    fast = fast->next->next;
+  }
+  GIDTestFailure* second = slow->next;
+  slow->next = NULL;
+
+  //Sort both halves, then merge them
+  GIDTestFailure* a = _gid_sort_test_failures(root);
+  GIDTestFailure* b = _gid_sort_test_failures(second);
+  GIDTestFailure* first = NULL;
+  GIDTestFailure** tail = &first;
+  while(a != NULL && b != NULL)
+  {
+    if(b->configuration_index < a->configuration_index)
+    {
+      *tail = b;
+      b = b->next;
+    }
+    else
+    {
+      *tail = a;
+      a = a->next;
+    }
+    tail = &(*tail)->next;
   }
+  *tail = a != NULL ? a : b;
+  return first;
 }
 
-/* Contains information about a test. */
-typedef struct GIDTest
+/* Describes which values of a parameter the failures of a GIDFailureGroup
+ * had. */
+typedef struct GIDParamSpread
 {
-  /* The name of the test. */
-  const char* name;
-
-  /* Pointer to the GIDParamBase of the first parameter in this test. */
-  GIDParamBase* first_param;
-
-  /* Pointer to the GIDParamBase of the last parameter in this test. */
-  GIDParamBase* last_param;
-
-  /* Pointer to the next linked GIDTest, or NULL. */
-  struct GIDTest* next;
-
-  /* The total number of configurations (combinations of all parameters)
-   * for this test. */
-  int32_t total_config_count;
-
-  /* The number of configurations that passed. */
-  int32_t pass_config_count;
+  /* The lowest position of a value of the parameter. */
+  size_t min_position;
+
+  /* The highest position of a value of the parameter. */
+  size_t max_position;
+
+  /* Bit N is set if the value at position N was seen, for the first 64
+   * positions. */
+  uint64_t position_mask;
+} GIDParamSpread;
+
+/* A group of failures of a test that have the same cause: the same source
+ * file, line, step and message template (see _gid_get_message_template).
+ * Only a few example failures are kept, so when one bug fails every
+ * configuration of a test, the memory and output stay the size of one
+ * group. */
+typedef struct GIDFailureGroup
+{
+  /* The source file of the failures. */
+  const char* source_file;
 
-  /* The number of configurations that were run. */
-  int32_t run_config_count;
+  /* The line of the failures. */
+  int line;
 
-  /* The number of configurations that were skipped. */
-  int32_t skip_config_count;
+  /* The GIDTestStep of the failures. */
+  GIDTestStep step;
 
-  /* The current status of this test. */
-  GIDTestStatus status;
+  /* The message of the failures, with the parts that usually differ
+   * between configurations (such as numbers) replaced. */
+  char message_template[GID_MAX_MESSAGE_LENGTH];
 
-  /* The total amount of time to execute all configurations of this test,
-   * measured in milliseconds. */
-  int32_t total_runtime;
+  /* The number of failures in the group. */
+  uint64_t count;
 
-  /* Have all configurations of this test been run? */
-  int is_complete;
+  /* The failures with the lowest configuration indices, in order. */
+  GIDTestFailure* examples[GID_MAX_FAILURE_EXAMPLES];
 
-  /* Pointer to the GIDTestFailure of the first failure, or NULL. */
-  GIDTestFailure* first_failure;
+  /* The number of failures in 'examples'. */
+  size_t example_count;
 
-  /* Pointer to the GIDTestFailure of the last failure, or NULL. */
-  GIDTestFailure* last_failure;
+  /* The spread of the values of each parameter, indexed by slot, or NULL if
+   * the configurations can't be decoded. */
+  GIDParamSpread* params;
 
-} GIDTest;
+  /* Pointer to the next GIDFailureGroup, or NULL. */
+  struct GIDFailureGroup* next;
+} GIDFailureGroup;
 
-/* Creates a GIDTest.
- * @param name - The name of the test.
- * @returns - A pointer to the allocated GIDTest. */
-GIDTest* _gid_create_test(const char* name)
+/* Gets the template of a failure message, which is the message with the
+ * parts that usually depend on the configuration replaced: each number
+ * (including negative and hexadecimal numbers) becomes '#', and the contents
+ * of each quoted string, and each value after an '=' (as in 'i=3'), become
+ * '*'. Failures with the same template likely have the same cause.
+ * @param message - The message.
+ * @param dst - The destination buffer, of GID_MAX_MESSAGE_LENGTH chars. */
+void _gid_get_message_template(const char* message, char* dst)
 {
-  GIDTest* test = malloc(sizeof(GIDTest));
-  test->name = _gid_strclone(name);
+  size_t pos = 0;
+  const char* c = message;
+  while(*c != '\0' && pos + 1 < GID_MAX_MESSAGE_LENGTH)
+  {
+    if(*c == '=' && c[1] != '\0' && c[1] != ' ' && c[1] != '"')
+    {
+      //Skip the value, up to the next separator
+      dst[pos++] = *c++;
+      while(*c != '\0' && *c != ' ' && *c != ',' && *c != ';' && *c != ')'
+        && *c != '\n' && !(*c == '.' && (c[1] == '\0' || c[1] == ' '
+          || c[1] == '\n')))
+      {
+        c++;
+      }
+      if(pos + 1 < GID_MAX_MESSAGE_LENGTH)
+        dst[pos++] = '*';
+    }
+    else if((*c >= '0' && *c <= '9')
+      || (*c == '-' && c[1] >= '0' && c[1] <= '9'))
+    {
+      if(*c == '-')
+        c++;
+      if(c[0] == '0' && (c[1] == 'x' || c[1] == 'X'))
+        c += 2;
+      while((*c >= '0' && *c <= '9')
+        || (*c >= 'a' && *c <= 'f')
+        || (*c >= 'A' && *c <= 'F')
+        || (*c == '.' && c[1] >= '0' && c[1] <= '9'))
+      {
+        c++;
+      }
+      dst[pos++] = '#';
+    }
+    else if(*c == '"')
+    {
+      const char* end = strchr(c + 1, '"');
+      if(end == NULL)
+      {
+        dst[pos++] = *c++;
+        continue;
+      }
+      dst[pos++] = '"';
+      if(pos + 1 < GID_MAX_MESSAGE_LENGTH)
+        dst[pos++] = '*';
+      if(pos + 1 < GID_MAX_MESSAGE_LENGTH)
+        dst[pos++] = '"';
+      c = end + 1;
+    }
+    else
+    {
+      dst[pos++] = *c++;
+    }
+  }
+  dst[pos] = '\0';
+}
+
+/* Structure that contains time tracking data. Timers are small enough to
+ * live on the stack or inside other structures, so timing a run doesn't
+ * allocate memory. */
+typedef struct GIDTimer
+{
+  /* The time of the monotonic clock when the timer started, in
+   * nanoseconds (see _gid_get_clock). */
+  uint64_t start;
+} GIDTimer;
+
+/* Gets the time of a monotonic clock, which isn't affected by changes to the
+ * system time.
+ * @returns - The time in nanoseconds, since an arbitrary starting point. */
+uint64_t _gid_get_clock()
+{
+#ifdef _WIN32
+  LARGE_INTEGER count;
+  LARGE_INTEGER frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  uint64_t ticks = (uint64_t)count.QuadPart;
+  uint64_t perSecond = (uint64_t)frequency.QuadPart;
+  //Split the conversion so that it doesn't overflow
+  return (ticks / perSecond) * 1000000000
+    + (ticks % perSecond) * 1000000000 / perSecond;
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/* Starts (or restarts) a GIDTimer from zero.
+ * @param timer - Pointer to the GIDTimer. */
+void _gid_start_timer(GIDTimer* timer)
+{
+  timer->start = _gid_get_clock();
+}
+
+/* Gets the elapsed time of a GIDTimer.
+ * @param timer - Pointer to the GIDTimer.
+ * @returns - The elapsed time of the timer, in nanoseconds. */
+uint64_t _gid_read_timer(const GIDTimer* timer)
+{
+  return _gid_get_clock() - timer->start;
+}
+
+/* Contains the measurement of one configuration of a Benchmark. */
+typedef struct GIDBenchmarkStats
+{
+  /* The median time of one iteration, in nanoseconds. */
+  double nanos_per_op;
+
+  /* The number of iterations in each measured batch. */
+  uint64_t iterations;
+
+  /* The number of batches that were measured. */
+  uint32_t sample_count;
+
+  /* The number of bytes that each iteration processes (see
+   * set_bytes_per_op), or zero if this isn't known. */
+  uint64_t bytes_per_op;
+} GIDBenchmarkStats;
+
+/* Contains the measurement of one configuration of a Benchmark, in a linked
+ * list of the measurements of all configurations of the Benchmark. The
+ * configuration string isn't stored, since it can be generated from the
+ * index when the results are printed. */
+typedef struct GIDBenchmarkResult
+{
+  /* The zero-based index of the configuration that was measured. */
+  uint64_t configuration_index;
+
+  /* The measurement. */
+  GIDBenchmarkStats stats;
+
+  /* The index of the record of the configuration in the binary results
+   * file, or UINT64_MAX if it has none. */
+  uint64_t record_index;
+
+  /* Pointer to the next GIDBenchmarkResult, if any. */
+  struct GIDBenchmarkResult* next;
+} GIDBenchmarkResult;
+
+/* Creates a GIDBenchmarkResult.
+ * @param configIndex - The zero-based index of the configuration.
+ * @param stats - Pointer to the GIDBenchmarkStats of the measurement.
+ * @param recordIndex - The index of the record of the configuration in the
+ *        binary results file, or UINT64_MAX if it has none.
+ * @returns - A pointer to the allocated GIDBenchmarkResult. */
+GIDBenchmarkResult* _gid_create_benchmark_result(
+  uint64_t configIndex,
+  const GIDBenchmarkStats* stats,
+  uint64_t recordIndex)
+{
+  GIDBenchmarkResult* ret = malloc(sizeof(GIDBenchmarkResult));
+  ret->configuration_index = configIndex;
+  ret->stats = *stats;
+  ret->record_index = recordIndex;
+  ret->next = NULL;
+  return ret;
+}
+
+/* Frees a linked list of GIDBenchmarkResults.
+ * @param root - Pointer to the root GIDBenchmarkResult to free. */
+void _gid_free_benchmark_results(GIDBenchmarkResult* root)
+{
+  while(root != NULL)
+  {
+    GIDBenchmarkResult* next = root->next;
+    free(root);
+    root = next;
+  }
+}
+
+/* Compares two GIDBenchmarkResult pointers by configuration index, for
+ * qsort.
+ * @param a - Pointer to the first GIDBenchmarkResult pointer.
+ * @param b - Pointer to the second GIDBenchmarkResult pointer.
+ * @returns - Negative if 'a' comes first, positive if 'b' comes first, or
+ *          zero if they are equal. */
+int _gid_compare_benchmark_results(const void* a, const void* b)
+{
+  uint64_t x = (*(const GIDBenchmarkResult* const*)a)->configuration_index;
+  uint64_t y = (*(const GIDBenchmarkResult* const*)b)->configuration_index;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/* Sorts a linked list of GIDBenchmarkResults by their configuration index.
+ * @param root - Pointer to the root GIDBenchmarkResult of the list to sort.
+ * @returns - Pointer to the root GIDBenchmarkResult of the sorted list. */
+GIDBenchmarkResult* _gid_sort_benchmark_results(GIDBenchmarkResult* root)
+{
+  size_t count = 0;
+  for(GIDBenchmarkResult* cur = root; cur != NULL; cur = cur->next)
+    count++;
+  if(count < 2)
+    return root;
+
+  GIDBenchmarkResult** array = malloc(sizeof(GIDBenchmarkResult*) * count);
+  size_t i = 0;
+  for(GIDBenchmarkResult* cur = root; cur != NULL; cur = cur->next)
+    array[i++] = cur;
+  qsort(array, count, sizeof(GIDBenchmarkResult*),
+    _gid_compare_benchmark_results);
+  for(i = 0; i + 1 < count; i++)
+    array[i]->next = array[i + 1];
+  array[count - 1]->next = NULL;
+  root = array[0];
+  free(array);
+  return root;
+}
+
+/* Contains the heap allocations of one step (such as setup) of one
+ * configuration of a test. These are only counted when GID_WRAP_MALLOC is
+ * defined. Sizes are the usable sizes of the blocks, which may be a little
+ * larger than the sizes that were requested. */
+typedef struct GIDHeapStats
+{
+  /* The number of blocks that were allocated (or reallocated). */
+  uint64_t alloc_count;
+
+  /* The total size of the blocks that were allocated, in bytes. */
+  uint64_t alloc_bytes;
+
+  /* The largest number of bytes that were allocated at once, counting from
+   * the start of the step, so memory that was allocated before the step and
+   * freed during it doesn't count. */
+  uint64_t peak_bytes;
+} GIDHeapStats;
+
+/* Contains the heap allocations of the configurations of a test. */
+typedef struct GIDHeapTally
+{
+  /* The sum of the GIDHeapStats of each step, indexed by GIDTestStep. */
+  GIDHeapStats steps[3];
+
+  /* The most allocations that any configuration made, in all steps. */
+  uint64_t max_alloc_count;
+
+  /* The index of the configuration that made the most allocations. If more
+   * than one did, this is the lowest index. */
+  uint64_t max_alloc_index;
+
+  /* The highest peak of any step of any configuration, in bytes. */
+  uint64_t max_peak_bytes;
+
+  /* The index of the configuration that had the highest peak. If more than
+   * one did, this is the lowest index. */
+  uint64_t max_peak_index;
+} GIDHeapTally;
+
+/* Adds the heap allocations of one configuration to a GIDHeapTally.
+ * @param tally - Pointer to the GIDHeapTally.
+ * @param configIndex - The zero-based index of the configuration.
+ * @param steps - The GIDHeapStats of each step of the configuration, indexed
+ *        by GIDTestStep. */
+void _gid_add_heap_stats(
+  GIDHeapTally* tally,
+  uint64_t configIndex,
+  const GIDHeapStats* steps)
+{
+  uint64_t allocCount = 0;
+  uint64_t peakBytes = 0;
+  for(int i = 0; i < 3; i++)
+  {
+    tally->steps[i].alloc_count += steps[i].alloc_count;
+    tally->steps[i].alloc_bytes += steps[i].alloc_bytes;
+    tally->steps[i].peak_bytes += steps[i].peak_bytes;
+    allocCount += steps[i].alloc_count;
+    if(steps[i].peak_bytes > peakBytes)
+      peakBytes = steps[i].peak_bytes;
+  }
+
+  //Ties go to the lowest index, so the result doesn't depend on the runner
+  if(allocCount > tally->max_alloc_count
+    || (allocCount == tally->max_alloc_count
+      && allocCount > 0
+      && configIndex < tally->max_alloc_index))
+  {
+    tally->max_alloc_count = allocCount;
+    tally->max_alloc_index = configIndex;
+  }
+  if(peakBytes > tally->max_peak_bytes
+    || (peakBytes == tally->max_peak_bytes
+      && peakBytes > 0
+      && configIndex < tally->max_peak_index))
+  {
+    tally->max_peak_bytes = peakBytes;
+    tally->max_peak_index = configIndex;
+  }
+}
+
+/* Adds one GIDHeapTally to another.
+ * @param dst - Pointer to the GIDHeapTally to add to.
+ * @param src - Pointer to the GIDHeapTally to add. */
+void _gid_merge_heap_tally(GIDHeapTally* dst, const GIDHeapTally* src)
+{
+  for(int i = 0; i < 3; i++)
+  {
+    dst->steps[i].alloc_count += src->steps[i].alloc_count;
+    dst->steps[i].alloc_bytes += src->steps[i].alloc_bytes;
+    dst->steps[i].peak_bytes += src->steps[i].peak_bytes;
+  }
+  if(src->max_alloc_count > dst->max_alloc_count
+    || (src->max_alloc_count == dst->max_alloc_count
+      && src->max_alloc_count > 0
+      && src->max_alloc_index < dst->max_alloc_index))
+  {
+    dst->max_alloc_count = src->max_alloc_count;
+    dst->max_alloc_index = src->max_alloc_index;
+  }
+  if(src->max_peak_bytes > dst->max_peak_bytes
+    || (src->max_peak_bytes == dst->max_peak_bytes
+      && src->max_peak_bytes > 0
+      && src->max_peak_index < dst->max_peak_index))
+  {
+    dst->max_peak_bytes = src->max_peak_bytes;
+    dst->max_peak_index = src->max_peak_index;
+  }
+}
+
+/* Gets the number of heap allocations in a GIDHeapTally, in all steps.
+ * @param tally - Pointer to the GIDHeapTally.
+ * @returns - The number of allocations. */
+uint64_t _gid_get_heap_alloc_count(const GIDHeapTally* tally)
+{
+  return tally->steps[GID_STEP_SETUP].alloc_count
+    + tally->steps[GID_STEP_RUN].alloc_count
+    + tally->steps[GID_STEP_TEARDOWN].alloc_count;
+}
+
+#ifdef GID_WRAP_MALLOC
+/* Non-zero if heap allocations are counted. */
+#define _gid_is_heap_counted (1)
+
+/* The GIDHeapStats of the step that the calling thread is running, or NULL
+ * if it isn't running a step, in which case allocations aren't counted. */
+__thread GIDHeapStats* _gid_heap_stats = NULL;
+
+/* The number of bytes that the calling thread has allocated (and not freed)
+ * since the start of its current step. This is negative if the step freed
+ * more than it allocated. */
+__thread int64_t _gid_heap_live_bytes = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+/* Counts a block that was allocated in the current step, if any.
+ * @param ptr - Pointer to the block, or NULL if the allocation failed. */
+void _gid_count_alloc(void* ptr)
+{
+  if(ptr == NULL || _gid_heap_stats == NULL)
+    return;
+  size_t size = malloc_usable_size(ptr);
+  _gid_heap_stats->alloc_count++;
+  _gid_heap_stats->alloc_bytes += size;
+  _gid_heap_live_bytes += size;
+  if(_gid_heap_live_bytes > (int64_t)_gid_heap_stats->peak_bytes)
+    _gid_heap_stats->peak_bytes = (uint64_t)_gid_heap_live_bytes;
+}
+
+/* Counts a block that is about to be freed in the current step, if any.
+ * @param ptr - Pointer to the block, or NULL. */
+void _gid_count_free(void* ptr)
+{
+  if(ptr != NULL && _gid_heap_stats != NULL)
+    _gid_heap_live_bytes -= malloc_usable_size(ptr);
+}
+
+/* Replaces malloc when linked with '--wrap=malloc' (see GID_WRAP_MALLOC). */
+void* __wrap_malloc(size_t size)
+{
+  void* ptr = __real_malloc(size);
+  _gid_count_alloc(ptr);
+  return ptr;
+}
+
+/* Replaces calloc when linked with '--wrap=calloc'. */
+void* __wrap_calloc(size_t count, size_t size)
+{
+  void* ptr = __real_calloc(count, size);
+  _gid_count_alloc(ptr);
+  return ptr;
+}
+
+/* Replaces realloc when linked with '--wrap=realloc'. A block that moves or
+ * changes size counts as freeing the old block and allocating a new one. */
+void* __wrap_realloc(void* ptr, size_t size)
+{
+  size_t oldSize = ptr != NULL && _gid_heap_stats != NULL
+    ? malloc_usable_size(ptr)
+    : 0;
+  void* ret = __real_realloc(ptr, size);
+  if(ret != NULL || size == 0)
+  {
+    //The old block is gone, unless the reallocation failed
+    if(_gid_heap_stats != NULL)
+      _gid_heap_live_bytes -= oldSize;
+    _gid_count_alloc(ret);
+  }
+  return ret;
+}
+
+/* Replaces free when linked with '--wrap=free'. */
+void __wrap_free(void* ptr)
+{
+  _gid_count_free(ptr);
+  __real_free(ptr);
+}
+#else
+#define _gid_is_heap_counted (0)
+#endif
+
+/* Identifies each hardware performance counter, as an index into the values
+ * of a GIDPerfStats. */
+typedef enum GIDPerfCounter
+{
+  GID_PERF_CYCLES,
+  GID_PERF_INSTRUCTIONS,
+  GID_PERF_BRANCHES,
+  GID_PERF_BRANCH_MISSES,
+  GID_PERF_L1D_MISSES,
+  GID_PERF_LLC_MISSES
+} GIDPerfCounter;
+
+/* The names of the hardware performance counters, indexed by GIDPerfCounter. */
+const char* _gid_perf_counter_names[GID_PERF_COUNTER_COUNT] =
+{
+  "cycles",
+  "instructions",
+  "branches",
+  "branch misses",
+  "L1D misses",
+  "LLC misses"
+};
+
+/* Contains the hardware performance counters of the run step of one
+ * configuration of a test. */
+typedef struct GIDPerfStats
+{
+  /* A bit for each GIDPerfCounter that was measured. Zero means that no
+   * counters were measured. */
+  uint32_t mask;
+
+  /* The value of each counter, indexed by GIDPerfCounter. If the counters had
+   * to share the hardware with other events, the values are scaled up to the
+   * whole run step. */
+  uint64_t values[GID_PERF_COUNTER_COUNT];
+} GIDPerfStats;
+
+/* Contains the sums of the hardware performance counters of the
+ * configurations of a test, for each row that _gid_print_perf_counters
+ * prints. Row zero has every configuration, and each value of each
+ * parameter that is broken down has a row (see 'perf_rows' in GIDTest). The
+ * counters of each configuration are added as soon as it finishes, so the
+ * memory doesn't grow with the number of configurations. */
+typedef struct GIDPerfTally
+{
+  /* A bit for each GIDPerfCounter that was measured in every configuration
+   * that was added. */
+  uint32_t mask;
+
+  /* The sum of each counter in each row, indexed by
+   * row * GID_PERF_COUNTER_COUNT + GIDPerfCounter, or NULL if no
+   * configuration was added yet. */
+  double* sums;
+
+  /* The number of configurations that were added to each row. */
+  uint64_t* counts;
+} GIDPerfTally;
+
+/* Contains the hardware performance counters of one thread. The counters are
+ * opened the first time that they are started, since they count the events
+ * of the thread that opened them. */
+typedef struct GIDPerfCounters
+{
+  /* The file descriptor of each counter, indexed by GIDPerfCounter, or -1 if
+   * the counter couldn't be opened. The first counter that opened leads the
+   * group, so all of them are started and read at once. */
+  int fds[GID_PERF_COUNTER_COUNT];
+
+  /* The file descriptor of the leader of the group, or -1 if no counter
+   * could be opened. */
+  int leader;
+
+  /* Have the counters been opened (or tried to)? Non-zero means yes. */
+  int is_opened;
+} GIDPerfCounters;
+
+/* Initializes a GIDPerfCounters, without opening the counters.
+ * @param counters - Pointer to the GIDPerfCounters. */
+void _gid_init_perf_counters(GIDPerfCounters* counters)
+{
+  for(int i = 0; i < GID_PERF_COUNTER_COUNT; i++)
+    counters->fds[i] = -1;
+  counters->leader = -1;
+  counters->is_opened = 0;
+}
+
+/* Opens the hardware performance counters of the calling thread. They only
+ * count events in user space, so they work without special privileges.
+ * @param counters - Pointer to the GIDPerfCounters.
+ * @returns - Non-zero if at least one counter was opened, otherwise zero. */
+int _gid_open_perf_counters(GIDPerfCounters* counters)
+{
+  counters->is_opened = 1;
+#ifdef __linux__
+  const uint32_t types[GID_PERF_COUNTER_COUNT] =
+  {
+    PERF_TYPE_HARDWARE,
+    PERF_TYPE_HARDWARE,
+    PERF_TYPE_HARDWARE,
+    PERF_TYPE_HARDWARE,
+    PERF_TYPE_HW_CACHE,
+    PERF_TYPE_HARDWARE
+  };
+  const uint64_t configs[GID_PERF_COUNTER_COUNT] =
+  {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_L1D
+      | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_CACHE_MISSES
+  };
+  for(int i = 0; i < GID_PERF_COUNTER_COUNT; i++)
+  {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = types[i];
+    attr.config = configs[i];
+    attr.disabled = counters->leader < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP
+      | PERF_FORMAT_TOTAL_TIME_ENABLED
+      | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    counters->fds[i] = (int)syscall(
+      SYS_perf_event_open,
+      &attr,
+      0,//This thread
+      -1,//Any CPU
+      counters->leader,
+      0);
+    if(counters->fds[i] >= 0 && counters->leader < 0)
+      counters->leader = counters->fds[i];
+  }
+#endif
+  return counters->leader >= 0;
+}
+
+/* Closes the hardware performance counters.
+ * @param counters - Pointer to the GIDPerfCounters. */
+void _gid_close_perf_counters(GIDPerfCounters* counters)
+{
+#ifdef __linux__
+  for(int i = 0; i < GID_PERF_COUNTER_COUNT; i++)
+  {
+    if(counters->fds[i] >= 0)
+      close(counters->fds[i]);
+  }
+#endif
+  _gid_init_perf_counters(counters);
+}
+
+/* Resets and starts the hardware performance counters, opening them if they
+ * haven't been opened yet.
+ * @param counters - Pointer to the GIDPerfCounters. */
+void _gid_start_perf_counters(GIDPerfCounters* counters)
+{
+  if(!counters->is_opened)
+    _gid_open_perf_counters(counters);
+#ifdef __linux__
+  if(counters->leader >= 0)
+  {
+    ioctl(counters->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif
+}
+
+/* Stops the hardware performance counters and reads them.
+ * @param counters - Pointer to the GIDPerfCounters.
+ * @param dst - Pointer to the GIDPerfStats into which the values are written.
+ *        Its mask is zero if the counters couldn't be read. */
+void _gid_stop_perf_counters(GIDPerfCounters* counters, GIDPerfStats* dst)
+{
+  memset(dst, 0, sizeof(GIDPerfStats));
+#ifdef __linux__
+  if(counters->leader < 0)
+    return;
+  ioctl(counters->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  //The number of counters, the enabled and running times, then the values
+  uint64_t data[3 + GID_PERF_COUNTER_COUNT];
+  ssize_t size = read(counters->leader, data, sizeof(data));
+  if(size < (ssize_t)(sizeof(uint64_t) * 3)
+    || size < (ssize_t)(sizeof(uint64_t) * (3 + data[0])))
+    return;
+
+  //Scale up the counts if the counters were multiplexed with other events
+  if(data[2] == 0)
+    return;//The group never got the hardware, so nothing was counted
+  double scale = data[2] < data[1] ? (double)data[1] / data[2] : 1.0;
+  uint64_t next = 0;
+  for(int i = 0; i < GID_PERF_COUNTER_COUNT && next < data[0]; i++)
+  {
+    if(counters->fds[i] < 0)
+      continue;
+    dst->values[i] = (uint64_t)(data[3 + next] * scale);
+    dst->mask |= 1u << i;
+    next++;
+  }
+#endif
+}
+
+/* Contains information about a test. */
+typedef struct GIDTest
+{
+  /* The name of the test. */
+  const char* name;
+
+  /* Identifies the scope that contains the body of this test, within the
+   * function generated by the BEGIN_TEST_SUITE and END_TEST_SUITE macros.
+   * The suite function jumps directly to this scope when the test is run,
+   * so it doesn't need to walk the scopes of every other test. */
+  int scope;
+
+  /* The source file in which the test is defined. */
+  const char* source_file;
+
+  /* The line on which the test is defined. */
+  int line;
+
+  /* The zero-based position of this test among the tests of all suites, in
+   * the order that they were registered. */
+  uint32_t index;
+
+  /* Pointer to the GIDParamBase of the first parameter in this test. */
+  GIDParamBase* first_param;
+
+  /* Pointer to the GIDParamBase of the last parameter in this test. */
+  GIDParamBase* last_param;
+
+  /* The number of parameters in this test, which is also the number of
+   * slots that each run needs for the parameter values. */
+  size_t param_count;
+
+  /* Pointer to the next linked GIDTest, or NULL. */
+  struct GIDTest* next;
+
+  /* The total number of configurations (combinations of all parameters)
+   * for this test. When a covering array is used, this is only the number of
+   * configurations in the covering array. When configurations are sampled,
+   * this is only the size of the sample, and it shrinks to the number that
+   * were run if the time budget runs out. When the tests are split into
+   * shards, this is only the number of configurations in the shard that this
+   * process runs, which may be zero (see _gid_select_shard). */
+  uint64_t total_config_count;
+
+  /* Non-zero if the number of configurations doesn't fit in 64 bits, in
+   * which case the test fails without running (see
+   * _gid_fail_config_overflow). */
+  int has_config_overflow;
+
+  /* The index of each configuration that is run, in the order that they are
+   * run, or NULL to run every configuration in order. The position of a
+   * configuration in this array is its 'number' (see
+   * _gid_get_config_index). */
+  uint64_t* config_indices;
+
+  /* The number of the first configuration that is run. This is zero unless
+   * the tests are split into shards. */
+  uint64_t first_config_number;
+
+  /* The number of configurations that are shuffled into a random order (see
+   * _gid_select_sample), or zero to run them in order. */
+  uint64_t shuffle_count;
+
+  /* The key of the random order of the shuffled configurations. */
+  uint64_t shuffle_key;
+
+  /* The strength of the covering array to run instead of every combination
+   * of parameters (see _gid_build_covering_array), zero to run every
+   * combination, or -1 to use the GID_COVERAGE_STRENGTH option. */
+  int32_t coverage_strength;
+
+  /* The longest time that each configuration of this test may run, in
+   * milliseconds, zero for no limit, or -1 to use the GID_TIMEOUT option. */
+  int32_t timeout;
+
+  /* How much slower than its baseline each configuration of this Benchmark
+   * may be before it fails, as a percentage, or -1 to use the
+   * GID_REGRESSION_THRESHOLD option. */
+  int32_t regression_threshold;
+
+  /* The number of configurations that passed. */
+  uint64_t pass_config_count;
+
+  /* The number of configurations that were run. */
+  uint64_t run_config_count;
+
+  /* The number of configurations that were skipped. */
+  uint64_t skip_config_count;
+
+  /* The current status of this test. */
+  GIDTestStatus status;
+
+  /* The total amount of time to execute all configurations of this test,
+   * measured in nanoseconds. */
+  uint64_t total_runtime;
+
+  /* Have all configurations of this test been run? */
+  int is_complete;
+
+  /* Pointer to the first GIDFailureGroup, or NULL. Once the test is
+   * complete, the groups are ordered by their first example. */
+  GIDFailureGroup* first_failure_group;
+
+  /* Pointer to the last GIDFailureGroup, or NULL. */
+  GIDFailureGroup* last_failure_group;
+
+  /* The number of GIDFailureGroups. */
+  size_t failure_group_count;
+
+  /* The number of failures that didn't fit in any GIDFailureGroup. */
+  uint64_t ungrouped_failure_count;
+
+  /* Pointer to the GIDTestFailure of the first example failure of all
+   * groups, ordered by configuration index, or NULL. This is only set once
+   * the test is complete (see _gid_finish_failure_groups). */
+  GIDTestFailure* first_failure;
+
+  /* Pointer to the GIDTestFailure of the last example failure, or NULL. */
+  GIDTestFailure* last_failure;
+
+  /* The GIDArena of the failure groups and their examples. */
+  GIDArena failure_arena;
+
+  /* Scratch for the positions and values of parameters when failures are
+   * added to the groups, or NULL until the first failure. Each has
+   * param_count + 1 elements, in the failure_arena. */
+  size_t* failure_positions;
+  GIDParamValue* failure_values;
+
+  /* Pointer to the GIDBenchmarkResult of the first configuration that was
+   * measured, or NULL. Only a Benchmark has results. */
+  GIDBenchmarkResult* first_benchmark;
+
+  /* Pointer to the GIDBenchmarkResult of the last configuration that was
+   * measured, or NULL. */
+  GIDBenchmarkResult* last_benchmark;
+
+  /* The first row of the hardware performance counters of each parameter,
+   * indexed by slot, or zero if the values of the parameter aren't broken
+   * down. NULL unless the counters are measured (see the GID_PERF_COUNTERS
+   * option and _gid_init_perf_rows). */
+  size_t* perf_rows;
+
+  /* The number of rows of the hardware performance counters, including row
+   * zero, which has every configuration. */
+  size_t perf_row_count;
+
+  /* The hardware performance counters of the configurations that were
+   * measured. */
+  GIDPerfTally perf;
+
+  /* The heap allocations of the configurations that were run, which are only
+   * counted when GID_WRAP_MALLOC is defined. */
+  GIDHeapTally heap;
+
+  /* The most bytes that the run step of each configuration may have
+   * allocated at once (see PeakHeapBudget), or UINT64_MAX for no limit. */
+  uint64_t peak_heap_budget;
+
+  /* The most allocations that the run step of each configuration may make
+   * (see AllocCountBudget), or UINT64_MAX for no limit. */
+  uint64_t alloc_count_budget;
+
+} GIDTest;
+
+/* Creates a GIDTest in the registration arena.
+ * @param name - The name of the test. This isn't copied, so it must be a
+ *        string literal.
+ * @param srcFile - The source file in which the test is defined. This must
+ *        remain valid for the life of the test, such as __FILE__.
+ * @param line - The line on which the test is defined.
+ * @param scope - Identifies the scope that contains the body of the test.
+ * @returns - A pointer to the allocated GIDTest. */
+GIDTest* _gid_create_test(
+  const char* name,
+  const char* srcFile,
+  int line,
+  int scope)
+{
+  GIDTest* test = _gid_arena_alloc(&_gid_registration_arena, sizeof(GIDTest));
+  test->name = name;
+  test->scope = scope;
+  test->source_file = srcFile;
+  test->line = line;
+  test->index = 0;
   test->first_param = NULL;
   test->last_param = NULL;
+  test->param_count = 0;
   test->next = NULL;
   test->total_config_count = 1;
+  test->has_config_overflow = 0;
+  test->config_indices = NULL;
+  test->first_config_number = 0;
+  test->shuffle_count = 0;
+  test->shuffle_key = 0;
+  test->coverage_strength = -1;
+  test->timeout = -1;
+  test->regression_threshold = -1;
   test->pass_config_count = 0;
   test->run_config_count = 0;
   test->skip_config_count = 0;
   test->status = GID_TEST_PENDING;
   test->total_runtime = 0;
   test->is_complete = 0;
+  test->first_failure_group = NULL;
+  test->last_failure_group = NULL;
+  test->failure_group_count = 0;
+  test->ungrouped_failure_count = 0;
   test->first_failure = NULL;
   test->last_failure = NULL;
+  memset(&test->failure_arena, 0, sizeof(GIDArena));
+  test->failure_positions = NULL;
+  test->failure_values = NULL;
+  test->first_benchmark = NULL;
+  test->last_benchmark = NULL;
+  test->perf_rows = NULL;
+  test->perf_row_count = 0;
+  memset(&test->perf, 0, sizeof(GIDPerfTally));
+  memset(&test->heap, 0, sizeof(GIDHeapTally));
+  test->peak_heap_budget = UINT64_MAX;
+  test->alloc_count_budget = UINT64_MAX;
   return test;
 }
 
@@ -1139,577 +2229,6219 @@ void _gid_add_param(GIDTest* test, GIDParamBase* param)
   if(prev != NULL)
     prev->next = param;
 
-  size_t valueCount = _gid_param_value_count(param);
-  if(valueCount > 0)/* Variables may have 0 values */
-    test->total_config_count *= valueCount;
-}
-
-/* Adds a failure to a test.
- * @param dst - Pointer to the GIDTest to which to add the failure.
- * @param failure - Pointer to the GIDTestFailure to add. */
-void _gid_add_test_failure(GIDTest* dst, GIDTestFailure* failure)
-{
-  GIDTestFailure* prev = dst->last_failure;
-  dst->last_failure = failure;
+  param->slot = test->param_count;
+  test->param_count++;
 
-  if(dst->first_failure == NULL)
-    dst->first_failure = failure;
-  if(prev != NULL)
-    prev->next = failure;
+  uint64_t valueCount = _gid_param_value_count(param);
+  if(param->has_value_overflow)
+    test->has_config_overflow = 1;
+  else if(valueCount > 0)/* Variables may have 0 values */
+  {
+    if(test->total_config_count > UINT64_MAX / valueCount)
+      test->has_config_overflow = 1;
+    else
+      test->total_config_count *= valueCount;
+  }
 }
 
-/* Resets all parameters, up to a specific limit, in a test to their initial
- * values.
- * @param test - Pointer to the GIDTest on which to reset the parameters.
- * @param limit - Pointer to the GIDParamBase of the first parameter that
- *        will NOT be reset. All parameters after this will also remain
- *        unchanged. */
-void _gid_reset_params_before(GIDTest* test, GIDParamBase* limit)
+/* Selects the value at a specific position of a parameter, for one run of a
+ * test.
+ * @param param - Pointer to the GIDParamBase of the parameter.
+ * @param position - The zero-based position of the value to select.
+ * @param positions - The position of each parameter, indexed by slot.
+ * @param values - The value of each parameter, indexed by slot. */
+void _gid_select_param_value(
+  const GIDParamBase* param,
+  size_t position,
+  size_t* positions,
+  GIDParamValue* values)
 {
-  GIDParamBase* cur = test->first_param;
-  while(cur != limit)
-  {
-    _gid_param_reset_value(cur);
-    cur = cur->next;
-  }
+  positions[param->slot] = position;
+  _gid_param_get_value(param, position, &values[param->slot]);
 }
 
-/* Performs one cycle of combinations on the parameters for a specific test.
- * @param test - Pointer to the GIDTest on which to cycle the parameters.
+/* Selects the next configuration of a test. The parameters are cycled like
+ * an odometer, where the first parameter changes most often.
+ * @param test - Pointer to the GIDTest.
+ * @param positions - The position of each parameter, indexed by slot. These
+ *        must hold the current configuration, and will be updated to the next.
+ * @param values - The value of each parameter, indexed by slot.
  * @returns - Non-zero if there are more combinations through which to cycle,
- *            otherwise zero is returned. */
-int _gid_cycle_params(GIDTest* test)
+ *            otherwise zero is returned and the first configuration is
+ *            selected again. */
+int _gid_next_config(
+  const GIDTest* test,
+  size_t* positions,
+  GIDParamValue* values)
 {
-  GIDParamBase* cur = test->first_param;
+  const GIDParamBase* cur = test->first_param;
   while(cur != NULL)
   {
-    if(_gid_param_next_value(cur))
+    size_t count = _gid_param_value_count(cur);
+    if(positions[cur->slot] + 1 < count)
     {
-      //Reset everything before this
-      _gid_reset_params_before(test, cur);
+      _gid_select_param_value(cur, positions[cur->slot] + 1, positions, values);
       return 1;
     }
     else
     {
-      //This param is at max value, try to increment the next
+      //This param is at max value, reset it and try to increment the next
+      if(positions[cur->slot] != 0)
+        _gid_select_param_value(cur, 0, positions, values);
       cur = cur->next;
     }
   }
 
-  //If we made it here then there are no params
+  //If we made it here then there are no more combinations
   return 0;
 }
 
-/* Finds the GIDParamBase of a parameter with a specfiic name.
- * @param test - Pointer to the GIDTest that contains the parameter to find.
- * @param name - The name of the parameter to find.
- * @returns - Pointer to the GIDParamBase of the parameter, or NULL if it
- *          was not found. */
-GIDParamBase* _gid_find_param(GIDTest* test, const char* name)
+/* Selects a specific configuration of a test, without stepping through the
+ * configurations before it. The configuration index is treated as a
+ * mixed-radix number where each parameter is one digit, and the first
+ * parameter is the least significant digit (since _gid_next_config changes
+ * it most often). So the configurations are numbered in the same order that
+ * _gid_next_config visits them, starting with zero.
+ * @param test - Pointer to the GIDTest.
+ * @param index - The zero-based index of the configuration to select.
+ * @param positions - The position of each parameter, indexed by slot.
+ * @param values - The value of each parameter, indexed by slot.
+ * @returns - Non-zero if the configuration was selected. Zero means that the
+ *          index is beyond the last configuration, in which case the
+ *          positions and values are unchanged. */
+int _gid_decode_config_index(
+  const GIDTest* test,
+  uint64_t index,
+  size_t* positions,
+  GIDParamValue* values)
 {
-  GIDParamBase* cur = test->first_param;
+  //Validate the index first so that nothing changes when it's out of range
+  uint64_t remaining = index;
+  const GIDParamBase* cur = test->first_param;
+  while(cur != NULL)
+  {
+    uint64_t count = _gid_param_value_count(cur);
+    if(count > 0)
+      remaining /= count;
+    cur = cur->next;
+  }
+  if(remaining != 0)
+    return 0;
+
+  cur = test->first_param;
   while(cur != NULL)
   {
-    if(strncmp(cur->name, name, strlen(name)+1) == 0)
-      return cur;
+    uint64_t count = _gid_param_value_count(cur);
+    if(count > 0)/* Parameters with no values aren't digits */
+    {
+      _gid_select_param_value(cur, index % count, positions, values);
+      index /= count;
+    }
     else
-      cur = cur->next;
+    {
+      _gid_select_param_value(cur, 0, positions, values);
+    }
+    cur = cur->next;
   }
+  return 1;
+}
 
-  return NULL;
+/* Gets the index of a configuration of a test. This is the reverse of
+ * _gid_decode_config_index.
+ * @param test - Pointer to the GIDTest.
+ * @param positions - The position of each parameter, indexed by slot.
+ * @returns - The zero-based index of the configuration. */
+uint64_t _gid_encode_config_index(const GIDTest* test, const size_t* positions)
+{
+  uint64_t index = 0;
+  uint64_t radix = 1;
+  const GIDParamBase* cur = test->first_param;
+  while(cur != NULL)
+  {
+    uint64_t count = _gid_param_value_count(cur);
+    if(count > 0)
+    {
+      index += positions[cur->slot] * radix;
+      radix *= count;
+    }
+    cur = cur->next;
+  }
+  return index;
 }
 
-/* Defines the result of a run of a specific test configuration. */
-typedef enum GIDRunResult
+/* Mixes the bits of a 64-bit integer (the finalizer of SplitMix64), so that
+ * similar inputs give unrelated outputs.
+ * @param x - The integer to mix.
+ * @returns - The mixed integer. */
+uint64_t _gid_mix64(uint64_t x)
 {
-  /* The test configuration's result is still pending. */
-  GID_RUN_RESULT_PENDING,
+  x += UINT64_C(0x9E3779B97F4A7C15);
+  x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+  x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+  return x ^ (x >> 31);
+}
 
-  /* The test configuration has resulted in failure. */
-  GID_RUN_RESULT_FAILED,
-
-  /* The test configuration was skipped. */
-  GID_RUN_RESULT_SKIPPED,
-
-  /* The test configuration was run successfully. */
-  GID_RUN_RESULT_PASSED,
-} GIDRunResult;
-
-/* Contains information about a run of a specific configuration of a test. */
-typedef struct GIDRun
+/* Maps a number to a position in a random permutation of [0, count), without
+ * storing the permutation. The number is encrypted by a small Feistel
+ * network over the next power of four, and encrypted again until the result
+ * is in range (cycle walking), so every number maps to a different position.
+ * @param number - The number to map, which must be less than 'count'.
+ * @param count - The number of elements in the permutation.
+ * @param key - Selects the permutation.
+ * @returns - The position of the number in the permutation. */
+uint64_t _gid_permute(uint64_t number, uint64_t count, uint64_t key)
 {
-  /* String representation of the parameters of this test run.
-   * This includes the names and values of each parameter. */
-  char configuration[GID_MAX_CONFIGURATION_STRING_LENGTH];
-
-  /* The current run result. */
-  GIDRunResult run_result;
+  uint32_t halfBits = 1;
+  while(halfBits < 32 && (UINT64_C(1) << (halfBits * 2)) < count)
+    halfBits++;
+  uint64_t mask = (UINT64_C(1) << halfBits) - 1;
 
-  /* The current test step (such as setup) of this run. */
-  GIDTestStep step;
-
-  /* The total amount of time that this run took, including
-   * setup and teardown, measured in milliseconds. */
-  int32_t runtime;
-} GIDTestRun;
+  do
+  {
+    uint64_t left = number >> halfBits;
+    uint64_t right = number & mask;
+    for(uint64_t round = 0; round < 4; round++)
+    {
+      uint64_t next = left ^ (_gid_mix64(key ^ ((right << 2) | round)) & mask);
+      left = right;
+      right = next;
+    }
+    number = (left << halfBits) | right;
+  } while(number >= count);
+  return number;
+}
 
-/* Contains a set of similar tests. */
-typedef struct GIDTestSuite
+/* Gets the index of a configuration from its number. Configurations are
+ * numbered in the order that they are run, which is the same as their index
+ * unless only some of them are selected (such as by a covering array) or
+ * they are shuffled (see _gid_select_sample).
+ * @param test - Pointer to the GIDTest.
+ * @param number - The zero-based number of the configuration.
+ * @returns - The index of the configuration. */
+uint64_t _gid_get_config_index(const GIDTest* test, uint64_t number)
 {
-  /* The name of the test suite. */
-  const char* name;
-
-  /* Pointer to the first GIDTest, or NULL. */
-  GIDTest* first_test;
-
-  /* Pointer to the last GIDTest, or NULL. */
-  GIDTest* last_test;
-
-  /* Function that runs the test suite, as generated by the
-   * BEGIN_TEST_SUITE and END_TEST_SUITE macros. */
-  void (*func)();
-
-  /* Pointer to the next GIDTestSuite, if any. */
-  struct GIDTestSuite* next;
-} GIDTestSuite;
+  if(test->shuffle_count > 0)
+    number = _gid_permute(number, test->shuffle_count, test->shuffle_key);
+  if(test->config_indices != NULL)
+    return test->config_indices[number];
+  else
+    return number;
+}
 
-/* Creates a test suite.
- * @param name - The name of the test suite.
- * @param func - The function that was generated by the BEGIN_TEST_SUITE and
- *        END_TEST_SUITE macros.
- * @returns - A pointer to the allocated GIDTestSuite. */
-GIDTestSuite* _gid_create_test_suite(const char* name, void (*func)())
+/* Selects the configuration with a specific number.
+ * @param test - Pointer to the GIDTest.
+ * @param number - The zero-based number of the configuration.
+ * @param isNext - Non-zero if the configuration with the previous number is
+ *        currently selected, so the next one may be selected without
+ *        decoding its index.
+ * @param positions - The position of each parameter, indexed by slot.
+ * @param values - The value of each parameter, indexed by slot.
+ * @returns - The index of the configuration. */
+uint64_t _gid_select_config_number(
+  const GIDTest* test,
+  uint64_t number,
+  int isNext,
+  size_t* positions,
+  GIDParamValue* values)
 {
-  GIDTestSuite* suite = malloc(sizeof(GIDTestSuite));
-  suite->name = _gid_strclone(name);
-  suite->first_test = NULL;
-  suite->last_test = NULL;
-  suite->func = func;
-  suite->next = NULL;
-  return suite;
+  uint64_t index = _gid_get_config_index(test, number);
+  if(isNext && test->config_indices == NULL && test->shuffle_count == 0)
+    _gid_next_config(test, positions, values);
+  else
+    _gid_decode_config_index(test, index, positions, values);
+  return index;
 }
 
-/* Pointer to the first GIDTestSuite, or NULL. */
-GIDTestSuite* _gid_first_suite = NULL;
-
-/* Pointer to the last GIDTestSuite, or NULL. */
-GIDTestSuite* _gid_last_suite = NULL;
-
-/* Frees a test suite.
- * @param suite - Pointer to the GIDTestSuite to free. */
-void _gid_free_suite(GIDTestSuite* suite)
+/* Moves to the next combination of 'count' elements out of 'total', in
+ * lexicographic order.
+ * @param combo - The (ascending) indices of the elements in the combination.
+ * @param count - The number of elements in the combination.
+ * @param total - The number of elements to choose from.
+ * @returns - Non-zero if there was a next combination, otherwise zero. */
+int _gid_next_combination(size_t* combo, size_t count, size_t total)
 {
-  GIDTest* cur = suite->first_test;
-  while(cur != NULL)
+  size_t j = count;
+  while(j > 0)
   {
-    GIDTest* next = cur->next;
-    free((char*)cur->name);
-    _gid_free_params(cur->first_param);
-    _gid_free_test_failures(cur->first_failure);
-    free(cur);
-    cur = next;
+    j--;
+    if(combo[j] < total - count + j)
+    {
+      combo[j]++;
+      for(size_t m = j + 1; m < count; m++)
+        combo[m] = combo[m - 1] + 1;
+      return 1;
+    }
   }
-  free((char*)suite->name);
-  free(suite);
+  return 0;
 }
 
-/* Calculates a statistical summary of a particular test suite.
- * @param suite - Pointer to the GIDTestSuite from which to obtain the summary.
- * @param totalTests - Pointer to an integer that will be assigned to the total
- *        number of tests in the suite (not counting each configuration).
- * @param passTests - Pointer to an integer that will be assigned to the number
- *        of tests in the suite that had no failures under any configuration.
- * @param failTests - Pointer to an integer that will be assigned to the number
- *        of tests that had at least one failure in any configuration.
- * @param totalConfigs - The total number of configurations of all tests.
- * @param passConfigs - The number of passing configurations.
- * @param skipConfigs - The number of configurations that were skipped. */
-void _gid_get_suite_summary(
-  const GIDTestSuite* suite,
-  int32_t* totalTests,
-  int32_t* passTests,
-  int32_t* failTests,
-  int32_t* totalConfigs,
-  int32_t* passConfigs,
-  int32_t* skipConfigs)
+/* Gets the index of the tuple of values that a row of a covering array has
+ * for a combination of parameters, plus one more parameter.
+ * @param row - The position of each parameter in the row.
+ * @param combo - The indices of the parameters in the combination.
+ * @param comboSize - The number of parameters in the combination.
+ * @param counts - The number of values of each parameter.
+ * @param last - The index of the additional parameter.
+ * @param value - The position of the additional parameter.
+ * @param dst - Receives the index of the tuple.
+ * @returns - Non-zero if the index was found, or zero if the row doesn't yet
+ *          have a value for one of the parameters in the combination. */
+int _gid_get_tuple_index(
+  const size_t* row,
+  const size_t* combo,
+  size_t comboSize,
+  const size_t* counts,
+  size_t last,
+  size_t value,
+  uint64_t* dst)
 {
-  *totalTests = 0;
-  *passTests = 0;
-  *failTests = 0;
-  *totalConfigs = 0;
-  *passConfigs = 0;
-  *skipConfigs = 0;
-
-  GIDTest* test = suite->first_test;
-  while(test != NULL)
+  uint64_t index = 0;
+  for(size_t m = comboSize; m > 0; m--)
   {
-    *totalTests = *totalTests + 1;
-    if(test->status == GID_TEST_PASSED)
-      *passTests = *passTests + 1;
-    if(test->status == GID_TEST_FAILED)
-      *failTests = *failTests + 1;
-    *totalConfigs += test->total_config_count;
-    *passConfigs += test->pass_config_count;
-    *skipConfigs += test->skip_config_count;
-    test = test->next;
+    size_t position = row[combo[m - 1]];
+    if(position == (size_t)-1)
+      return 0;
+    index = index * counts[combo[m - 1]] + position;
   }
+  *dst = index * counts[last] + value;
+  return 1;
 }
 
-/* Prints a summary of the test results.
- * @returns - The exit code, where zero means all tests passed, and non-zero
- *          means that at least one test failed. */
-int _gid_summary()
+/* Compares two configuration indices, for qsort.
+ * @param a - Pointer to the first uint64_t.
+ * @param b - Pointer to the second uint64_t.
+ * @returns - Negative if a<b, positive if a>b, otherwise zero. */
+int _gid_compare_config_indices(const void* a, const void* b)
 {
-  int32_t totalSuites = 0;
-  int32_t passSuites = 0;
-  int32_t failSuites = 0;
-  int32_t totalTests = 0;
-  int32_t passTests = 0;
-  int32_t failTests = 0;
-  int32_t totalTestConfigs = 0;
-  int32_t passTestConfigs = 0;
-  int32_t skipTestConfigs = 0;
+  uint64_t x = *(const uint64_t*)a;
+  uint64_t y = *(const uint64_t*)b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
 
-  GIDTestSuite* suite = _gid_first_suite;
-  while(suite != NULL)
+/* The most tuples, or seed rows, that a covering array may track for one
+ * parameter. A test whose covering array would be larger runs every
+ * configuration instead. */
+#define GID_MAX_COVERING_TUPLES ((uint64_t)1 << 26)
+
+/* Builds a covering array for a test, so that only a small subset of its
+ * configurations is run, while every combination of values of any
+ * 'strength' parameters still appears in at least one configuration. For
+ * example, a strength of 2 (pairwise) tests every pair of values of every two
+ * parameters. The array is built by the In-Parameter-Order (IPOG) strategy:
+ * start with every combination of the first 'strength' parameters, then add
+ * one parameter at a time. Each existing row gets the value of the new
+ * parameter that covers the most uncovered tuples, then new rows are added
+ * for the tuples that are still uncovered. The result is deterministic.
+ * @param suiteName - The name of the suite that contains the test, for the
+ *        note that is printed if the covering array is too large to build.
+ * @param test - Pointer to the GIDTest. On success, its 'config_indices' and
+ *        'total_config_count' are updated.
+ * @param strength - The strength of the covering array.
+ * @returns - Non-zero if a covering array was built. Zero means that every
+ *          configuration must be run, such as when the test doesn't have
+ *          more parameters than the strength, when the covering array would
+ *          not be smaller, or when it has more than GID_MAX_COVERING_TUPLES
+ *          tuples or seed rows to track. */
+int _gid_build_covering_array(
+  const char* suiteName,
+  GIDTest* test,
+  int32_t strength)
+{
+  //Only parameters that have values take part, like in the config index
+  size_t k = 0;
+  for(GIDParamBase* cur = test->first_param; cur != NULL; cur = cur->next)
   {
-    totalSuites++;
-    int32_t cur_totalTests = 0,
-      cur_passTests = 0,
-      cur_failTests = 0,
-      cur_totalConfigs = 0,
-      cur_passConfigs = 0,
-      cur_skipConfigs = 0;
-
-    _gid_get_suite_summary(
-      suite,
-      &cur_totalTests,
-      &cur_passTests,
-      &cur_failTests,
-      &cur_totalConfigs,
-      &cur_passConfigs,
-      &cur_skipConfigs);
+    if(_gid_param_value_count(cur) > 0)
+      k++;
+  }
+  size_t t = strength > 0 ? (size_t)strength : 0;
+  if(t == 0 || t >= k)
+    return 0;
 
-    totalTests += cur_totalTests;
-    passTests += cur_passTests;
-    failTests += cur_failTests;
-    totalTestConfigs += cur_totalConfigs;
-    passTestConfigs += cur_passConfigs;
-    skipTestConfigs += cur_skipConfigs;
+  const size_t dontCare = (size_t)-1;
+  size_t* counts = malloc(sizeof(size_t) * k);
+  size_t p = 0;
+  for(GIDParamBase* cur = test->first_param; cur != NULL; cur = cur->next)
+  {
+    size_t count = _gid_param_value_count(cur);
+    if(count > 0)
+      counts[p++] = count;
+  }
 
-    if(cur_failTests > 0)
-      failSuites++;
+  //Start with every combination of the first t parameters
+  size_t rowCount = 1;
+  int ok = 1;
+  for(size_t m = 0; m < t && ok; m++)
+  {
+    if(counts[m] > GID_MAX_COVERING_TUPLES / rowCount)
+      ok = 0;
     else
-      passSuites++;
-
-    suite = suite->next;
+      rowCount *= counts[m];
+  }
+  size_t rowCapacity = rowCount * 2;
+  size_t* rows = ok ? malloc(sizeof(size_t) * k * rowCapacity) : NULL;
+  size_t* combo = malloc(sizeof(size_t) * t);
+  if(rows == NULL || combo == NULL)
+  {
+    printf("%s > %s: the covering array is too large to build, so every "
+      "configuration will be run.\n", suiteName, test->name);
+    free(combo);
+    free(rows);
+    free(counts);
+    return 0;
+  }
+  for(size_t r = 0; r < rowCount; r++)
+  {
+    size_t rest = r;
+    for(size_t m = 0; m < k; m++)
+    {
+      if(m < t)
+      {
+        rows[r * k + m] = rest % counts[m];
+        rest /= counts[m];
+      }
+      else
+      {
+        rows[r * k + m] = dontCare;
+      }
+    }
   }
 
-  printf("\n========SUMMARY========\n");
-  printf("%i suites tested, %i passed without failures, "
-    "and %i had at least one test failure.\n",
-    totalSuites,
-    passSuites,
-    failSuites);
-
-  printf("%i tests total, %i tests passed, and %i failed.\n",
-    totalTests,
-    passTests,
-    failTests);
-  printf("%i total test configurations, %i passed, %i failed, and "
-    "%i skipped.\n",
-    totalTestConfigs,
-    passTestConfigs,
-    totalTestConfigs-(passTestConfigs+skipTestConfigs),
-    skipTestConfigs);
-
-  if(failSuites > 0 || failTests > 0)
+  int tooLarge = 0;
+  for(size_t i = t; i < k && ok; i++)
   {
-    printf("\n\033[30;41m  Failures  \033[0m\n");
-    suite = _gid_first_suite;
-    while(suite != NULL)
+    //One flag per tuple of (t-1 earlier parameters, parameter i)
+    uint64_t tupleCount = 0;
+    for(size_t m = 0; m < t - 1; m++)
+      combo[m] = m;
+    do
     {
-      int32_t cur_totalTests = 0,
-        cur_passTests = 0,
-        cur_failTests = 0,
-        cur_totalConfigs = 0,
-        cur_passConfigs = 0,
-        cur_skipConfigs = 0;
+      uint64_t size = counts[i];
+      for(size_t m = 0; m < t - 1 && size <= GID_MAX_COVERING_TUPLES; m++)
+      {
+        if(counts[combo[m]] > GID_MAX_COVERING_TUPLES / size)
+          size = GID_MAX_COVERING_TUPLES + 1;
+        else
+          size *= counts[combo[m]];
+      }
+      tupleCount += size;
+    }
+    while(tupleCount <= GID_MAX_COVERING_TUPLES
+      && _gid_next_combination(combo, t - 1, i));
+    uint8_t* uncovered = tupleCount <= GID_MAX_COVERING_TUPLES
+      ? malloc(tupleCount)
+      : NULL;
+    if(uncovered == NULL)
+    {
+      ok = 0;//Too large to track, so run every configuration instead
+      tooLarge = 1;
+      break;
+    }
+    memset(uncovered, 1, tupleCount);
 
-      _gid_get_suite_summary(
-        suite,
-        &cur_totalTests,
-        &cur_passTests,
-        &cur_failTests,
-        &cur_totalConfigs,
-        &cur_passConfigs,
-        &cur_skipConfigs);
+    //Horizontal growth: give each row the value that covers the most tuples
+    for(size_t r = 0; r < rowCount; r++)
+    {
+      size_t* row = &rows[r * k];
+      size_t best = 0;
+      uint64_t bestGain = 0;
+      for(size_t value = 0; value < counts[i]; value++)
+      {
+        uint64_t gain = 0;
+        uint64_t offset = 0;
+        for(size_t m = 0; m < t - 1; m++)
+          combo[m] = m;
+        do
+        {
+          uint64_t index;
+          if(_gid_get_tuple_index(row, combo, t - 1, counts, i, value, &index)
+            && uncovered[offset + index])
+            gain++;
+          uint64_t size = counts[i];
+          for(size_t m = 0; m < t - 1; m++)
+            size *= counts[combo[m]];
+          offset += size;
+        }
+        while(_gid_next_combination(combo, t - 1, i));
+        if(gain > bestGain)
+        {
+          best = value;
+          bestGain = gain;
+        }
+      }
 
-      if(cur_failTests > 0
-        || (cur_totalConfigs != cur_passConfigs + cur_skipConfigs))
+      row[i] = best;
+      uint64_t offset = 0;
+      for(size_t m = 0; m < t - 1; m++)
+        combo[m] = m;
+      do
       {
-        GIDTest* test = suite->first_test;
-        while(test != NULL)
+        uint64_t index;
+        if(_gid_get_tuple_index(row, combo, t - 1, counts, i, best, &index))
+          uncovered[offset + index] = 0;
+        uint64_t size = counts[i];
+        for(size_t m = 0; m < t - 1; m++)
+          size *= counts[combo[m]];
+        offset += size;
+      }
+      while(_gid_next_combination(combo, t - 1, i));
+    }
+
+    //Vertical growth: cover the remaining tuples with new or unfilled rows
+    uint64_t offset = 0;
+    for(size_t m = 0; m < t - 1; m++)
+      combo[m] = m;
+    do
+    {
+      uint64_t size = counts[i];
+      for(size_t m = 0; m < t - 1; m++)
+        size *= counts[combo[m]];
+      for(uint64_t index = 0; index < size && ok; index++)
+      {
+        if(!uncovered[offset + index])
+          continue;
+
+        //Find a row that can hold the tuple, or add one
+        size_t r;
+        for(r = 0; r < rowCount; r++)
         {
-          if(test->first_failure != NULL)
+          const size_t* row = &rows[r * k];
+          uint64_t rest = index;
+          int fits = row[i] == rest % counts[i] || row[i] == dontCare;
+          rest /= counts[i];
+          for(size_t m = 0; m < t - 1 && fits; m++)
           {
-            printf("------------------------------------------------------\n");
-            GIDTestFailure* failure = test->first_failure;
-            while(failure != NULL)
+            size_t position = row[combo[m]];
+            fits = position == rest % counts[combo[m]] || position == dontCare;
+            rest /= counts[combo[m]];
+          }
+          if(fits)
+            break;
+        }
+        if(r == rowCount)
+        {
+          if(rowCount == rowCapacity)
+          {
+            size_t* grown = realloc(rows, sizeof(size_t) * k * rowCapacity * 2);
+            if(grown == NULL)
             {
-              const char* step;
-              switch(failure->step)
-              {
-                case GID_STEP_SETUP:
-                  step = "\t[Setup]";
-                  break;
-                case GID_STEP_TEARDOWN:
-                  step = "\t[Teardown]";
-                  break;
-                default:
-                  step = "";
-                  break;
-              }
-
-              printf("%s > %s(%s) Failed\n",
-                suite->name,
-                test->name,
-                failure->configuration);
-              printf("  Message:\t\033[31m%s\033[0m\n", failure->message);
-              printf("  Location:\t%s @%i%s\n",
-                failure->source_file,
-                failure->line,
-                step);
-              printf("\n");
-              failure = failure->next;
+              ok = 0;
+              tooLarge = 1;
+              break;
             }
+            rows = grown;
+            rowCapacity *= 2;
           }
+          for(size_t m = 0; m < k; m++)
+            rows[r * k + m] = dontCare;
+          rowCount++;
+        }
 
-          test = test->next;
+        size_t* row = &rows[r * k];
+        uint64_t rest = index;
+        row[i] = rest % counts[i];
+        rest /= counts[i];
+        for(size_t m = 0; m < t - 1; m++)
+        {
+          row[combo[m]] = rest % counts[combo[m]];
+          rest /= counts[combo[m]];
         }
+        uncovered[offset + index] = 0;
       }
-      suite = suite->next;
+      offset += size;
     }
+    while(ok && _gid_next_combination(combo, t - 1, i));
+    free(uncovered);
   }
 
-  return failSuites == 0 ? 0/*No-error*/ : -1/*Fail*/;
-}
-
-/* Frees all memory allocated for GID testing. */
-void _gid_free()
-{
-  GIDTestSuite* suite = _gid_first_suite;
-  while(suite != NULL)
+  uint64_t* indices = NULL;
+  if(ok && rowCount < test->total_config_count)
   {
-    GIDTestSuite* next = suite->next;
-    _gid_free_suite(suite);
-    suite = next;
+    indices = malloc(sizeof(uint64_t) * rowCount);
+    tooLarge = indices == NULL;
   }
-  _gid_first_suite = NULL;
-  _gid_last_suite = NULL;
-}
+  if(indices != NULL)
+  {
+    //Any value will do for the parameters that a row doesn't care about
+    for(size_t r = 0; r < rowCount; r++)
+    {
+      uint64_t index = 0;
+      uint64_t radix = 1;
+      for(size_t m = 0; m < k; m++)
+      {
+        size_t position = rows[r * k + m];
+        if(position != dontCare)
+          index += position * radix;
+        radix *= counts[m];
+      }
+      indices[r] = index;
+    }
 
-/* Runs all tests defined in each test suite, and prints a summary.
- * @returns - Zero if all tests passed, otherwise non-zero. */
-int gidunit()
-{
-  //Run the test suite functions
-  GIDTestSuite* suite = _gid_first_suite;
-  while(suite != NULL)
+    //Run them in order, without duplicates
+    qsort(indices, rowCount, sizeof(uint64_t), _gid_compare_config_indices);
+    size_t unique = 0;
+    for(size_t r = 0; r < rowCount; r++)
+    {
+      if(unique == 0 || indices[unique - 1] != indices[r])
+        indices[unique++] = indices[r];
+    }
+
+    free(test->config_indices);
+    test->config_indices = indices;
+    test->total_config_count = unique;
+  }
+  else
   {
-    suite->func();
-    suite = suite->next;
+    ok = 0;
   }
 
-  //Generate the summary
-  int ret = _gid_summary();
-  _gid_free();
-  return ret;
+  if(tooLarge)
+  {
+    printf("%s > %s: the covering array is too large to build, so every "
+      "configuration will be run.\n", suiteName, test->name);
+  }
+  free(combo);
+  free(rows);
+  free(counts);
+  return ok;
 }
 
-/* Registers a test suite.
- * @param suite - Pointer to the GIDTestSuite to register. */
-void _gid_add_test_suite(GIDTestSuite* suite)
+/* Shuffles the configurations of a test into a random order, and keeps only
+ * the first 'sampleCount' of them. Since every ordering is equally likely,
+ * the sample (and any prefix of it, such as the configurations that fit in a
+ * time budget) is chosen uniformly without replacement. The order depends
+ * only on the seed and the names of the suite and test, so the same seed
+ * always runs the same sample, no matter which other tests exist. This must
+ * be done after any covering array is built, which is then what gets sampled.
+ * @param test - Pointer to the GIDTest.
+ * @param suiteName - The name of the suite that contains the test.
+ * @param seed - The seed of the random order.
+ * @param sampleCount - The maximum number of configurations to run, or zero to
+ *        run all of them (in random order). */
+void _gid_select_sample(
+  GIDTest* test,
+  const char* suiteName,
+  uint64_t seed,
+  uint64_t sampleCount)
 {
-  GIDTestSuite* prev = _gid_last_suite;
-  _gid_last_suite = suite;
+  uint64_t hash =
+    _gid_hash_chars(_GID_HASH_BASIS, suiteName, strlen(suiteName));
+  hash = _gid_hash_chars(hash, "/", 1);
+  hash = _gid_hash_chars(hash, test->name, strlen(test->name));
+  test->shuffle_count = test->total_config_count;
+  test->shuffle_key = _gid_mix64(seed ^ _gid_mix64(hash));
+  if(sampleCount > 0 && sampleCount < test->shuffle_count)
+    test->total_config_count = sampleCount;
+}
 
-  if(_gid_first_suite == NULL)
-    _gid_first_suite = suite;
+/* Defines the result of a run of a specific test configuration. */
+typedef enum GIDRunResult
+{
+  /* The test configuration's result is still pending. */
+  GID_RUN_RESULT_PENDING,
+
+  /* The test configuration has resulted in failure. */
+  GID_RUN_RESULT_FAILED,
+
+  /* The test configuration was skipped. */
+  GID_RUN_RESULT_SKIPPED,
+
+  /* The test configuration was run successfully. */
+  GID_RUN_RESULT_PASSED,
+} GIDRunResult;
+
+/* Contains the state of a Benchmark while it measures one configuration.
+ * The body of the Benchmark is run in batches of the same number of
+ * iterations, and each batch is timed (see _gid_next_benchmark_batch). */
+typedef struct GIDBenchmark
+{
+  /* The measurement so far. Its 'iterations' is the size of the current
+   * batch, which is zero until the first batch starts. */
+  GIDBenchmarkStats stats;
+
+  /* Measures the current batch. */
+  GIDTimer timer;
+
+  /* Has the batch size grown large enough that each batch takes at least
+   * the target time? Non-zero means yes, so batches are being measured. */
+  int is_calibrated;
+
+  /* Has the measurement finished? Non-zero means yes. */
+  int is_complete;
+
+  /* The time of one iteration in the most recent batches, in nanoseconds.
+   * This is a ring buffer, indexed by the sample count. */
+  double samples[GID_BENCHMARK_SAMPLE_COUNT];
+} GIDBenchmark;
+
+/* Contains information about a run of a specific configuration of a test. */
+typedef struct GIDRun
+{
+  /* The zero-based index of this run's configuration, counting the
+   * configurations of the test in the order that they are run. */
+  uint64_t configuration_index;
+
+  /* String representation of the parameters of this test run.
+   * This includes the names and values of each parameter. Since most runs
+   * never need it, it is only generated on demand, see
+   * _gid_get_run_configuration. */
+  char configuration[GID_MAX_CONFIGURATION_STRING_LENGTH];
+
+  /* Has the 'configuration' string been generated? Zero means no. */
+  int has_configuration;
+
+  /* The current run result. */
+  GIDRunResult run_result;
+
+  /* The current test step (such as setup) of this run. */
+  GIDTestStep step;
+
+  /* The values of the test's parameters for this run, indexed by the
+   * 'slot' of each parameter's GIDParamBase. */
+  GIDParamValue* param_values;
+
+  /* The positions of the values in 'param_values', indexed the same way. */
+  const size_t* param_positions;
+
+  /* Pointer to the GIDTestFailure of the first failure of this run, or
+   * NULL. The runner moves the failures to the test when the run finishes. */
+  GIDTestFailure* first_failure;
+
+  /* Pointer to the GIDTestFailure of the last failure of this run, or NULL. */
+  GIDTestFailure* last_failure;
+
+  /* Pointer to the GIDArena from which the failures of this run are
+   * allocated. It must outlive the failures, wherever they are moved. */
+  GIDArena* failure_arena;
+
+  /* The total amount of time that this run took, including
+   * setup and teardown, measured in nanoseconds. */
+  uint64_t runtime;
+
+  /* The state of the measurement, if the test is a Benchmark. */
+  GIDBenchmark benchmark;
+
+  /* Pointer to the GIDPerfCounters of the thread that runs this run, or NULL
+   * to not measure the hardware performance counters. */
+  GIDPerfCounters* perf_counters;
+
+  /* The hardware performance counters of the run step, if they were
+   * measured. */
+  GIDPerfStats perf;
+
+  /* The heap allocations of each step, indexed by GIDTestStep. These are
+   * only counted when GID_WRAP_MALLOC is defined. */
+  GIDHeapStats heap[3];
+} GIDTestRun;
+
+/* Initializes a GIDTestRun for a specific configuration of a test.
+ * The fields are assigned one at a time so that the configuration buffer
+ * isn't cleared for every run.
+ * @param run - Pointer to the GIDTestRun to initialize.
+ * @param index - The zero-based index of the configuration.
+ * @param positions - The position of each parameter, indexed by slot.
+ * @param values - The value of each parameter, indexed by slot.
+ * @param failureArena - Pointer to the GIDArena from which to allocate the
+ *        failures of the run. */
+void _gid_init_run(
+  GIDTestRun* run,
+  uint64_t index,
+  const size_t* positions,
+  GIDParamValue* values,
+  GIDArena* failureArena)
+{
+  run->configuration_index = index;
+  run->has_configuration = 0;
+  run->run_result = GID_RUN_RESULT_PENDING;
+  run->step = GID_STEP_SETUP;
+  run->param_values = values;
+  run->param_positions = positions;
+  run->first_failure = NULL;
+  run->last_failure = NULL;
+  run->failure_arena = failureArena;
+  run->runtime = 0;
+  memset(&run->benchmark, 0, sizeof(GIDBenchmark));
+  run->perf_counters = NULL;
+  run->perf.mask = 0;
+  memset(run->heap, 0, sizeof(run->heap));
+}
+
+/* Gets the string representation of the configuration of a test run,
+ * generating it if this hasn't been done yet.
+ * @param test - Pointer to the GIDTest that is running.
+ * @param run - Pointer to the GIDTestRun.
+ * @returns - The configuration string, which is stored in the run. */
+const char* _gid_get_run_configuration(const GIDTest* test, GIDTestRun* run)
+{
+  if(!run->has_configuration)
+  {
+    _gid_get_params_string(
+      test->first_param,
+      run->param_positions,
+      run->configuration,
+      GID_MAX_CONFIGURATION_STRING_LENGTH);
+    run->has_configuration = 1;
+  }
+  return run->configuration;
+}
+
+/* Causes a test run to fail, and records the failure in the run.
+ * @param test - Pointer to the GIDTest that is running.
+ * @param run - Pointer to the GIDTestRun that failed.
+ * @param message - Message that explains why the run failed.
+ * @param srcFile - The source file in which the failure was detected.
+ * @param line - The line in the source file where the failure was detected. */
+void _gid_fail_run(
+  const GIDTest* test,
+  GIDTestRun* run,
+  const char* message,
+  const char* srcFile,
+  int line)
+{
+  run->run_result = GID_RUN_RESULT_FAILED;
+  GIDTestFailure* failure = _gid_create_test_failure(
+    run->failure_arena,
+    test->name,
+    _gid_get_run_configuration(test, run),
+    run->configuration_index,
+    message,
+    srcFile,
+    line,
+    run->step);
+
+  GIDTestFailure* prev = run->last_failure;
+  run->last_failure = failure;
+  if(run->first_failure == NULL)
+    run->first_failure = failure;
   if(prev != NULL)
-    prev->next = suite;
+    prev->next = failure;
 }
 
-/* Adds a test to a suite.
- * @param dst - Pointer to the destination GIDTestSuite.
- * @param test - Pointer to the GIDTest to add. */
-void _gid_add_test(GIDTestSuite* dst, GIDTest* test)
+/* Moves the failures of a test run to the end of a list of failures.
+ * @param first - Pointer to the first GIDTestFailure of the destination list.
+ * @param last - Pointer to the last GIDTestFailure of the destination list.
+ * @param run - Pointer to the GIDTestRun whose failures will be moved. */
+void _gid_move_run_failures(
+  GIDTestFailure** first,
+  GIDTestFailure** last,
+  GIDTestRun* run)
+{
+  if(run->first_failure == NULL)
+    return;
+  if(*first == NULL)
+    *first = run->first_failure;
+  else
+    (*last)->next = run->first_failure;
+  *last = run->last_failure;
+  run->first_failure = NULL;
+  run->last_failure = NULL;
+}
+
+/* Finds the GIDFailureGroup of a failure, without creating it.
+ * @param test - Pointer to the GIDTest.
+ * @param failure - Pointer to the GIDTestFailure.
+ * @param messageTemplate - The template of the message of the failure (see
+ *        _gid_get_message_template).
+ * @returns - Pointer to the GIDFailureGroup, or NULL if the test has no group
+ *          for the cause of the failure. */
+GIDFailureGroup* _gid_find_failure_group(
+  const GIDTest* test,
+  const GIDTestFailure* failure,
+  const char* messageTemplate)
+{
+  for(GIDFailureGroup* group = test->first_failure_group;
+    group != NULL;
+    group = group->next)
+  {
+    if(group->line == failure->line
+      && group->step == failure->step
+      && strcmp(group->message_template, messageTemplate) == 0
+      && strcmp(group->source_file, failure->source_file) == 0)
+    {
+      return group;
+    }
+  }
+  return NULL;
+}
+
+/* Checks if failures can be added to the groups of a test before the
+ * failures of lower configuration numbers are, which is when none of them
+ * could create a group. Which causes get one of the GID_MAX_FAILURE_GROUPS
+ * groups then doesn't depend on the order that the failures are added.
+ * @param test - Pointer to the GIDTest.
+ * @param first - Pointer to the first GIDTestFailure, or NULL. Every
+ *        failure that follows it is checked too.
+ * @returns - Non-zero if the failures can be added in any order. */
+int _gid_can_add_failures_early(
+  const GIDTest* test,
+  const GIDTestFailure* first)
+{
+  if(test->failure_group_count >= GID_MAX_FAILURE_GROUPS)
+    return 1;
+  char messageTemplate[GID_MAX_MESSAGE_LENGTH];
+  for(const GIDTestFailure* f = first; f != NULL; f = f->next)
+  {
+    _gid_get_message_template(f->message, messageTemplate);
+    if(_gid_find_failure_group(test, f, messageTemplate) == NULL)
+      return 0;
+  }
+  return 1;
+}
+
+/* Finds the GIDFailureGroup of a failure, creating it if the test has fewer
+ * than GID_MAX_FAILURE_GROUPS groups.
+ * @param test - Pointer to the GIDTest.
+ * @param failure - Pointer to the GIDTestFailure.
+ * @returns - Pointer to the GIDFailureGroup, or NULL if the failure has no
+ *          group and there is no room for another. */
+GIDFailureGroup* _gid_get_failure_group(
+  GIDTest* test,
+  const GIDTestFailure* failure)
+{
+  char messageTemplate[GID_MAX_MESSAGE_LENGTH];
+  _gid_get_message_template(failure->message, messageTemplate);
+  GIDFailureGroup* found =
+    _gid_find_failure_group(test, failure, messageTemplate);
+  if(found != NULL)
+    return found;
+  if(test->failure_group_count >= GID_MAX_FAILURE_GROUPS)
+    return NULL;
+
+  GIDFailureGroup* group =
+    _gid_arena_alloc(&test->failure_arena, sizeof(GIDFailureGroup));
+  group->source_file = failure->source_file;
+  group->line = failure->line;
+  group->step = failure->step;
+  memcpy(group->message_template, messageTemplate, GID_MAX_MESSAGE_LENGTH);
+  group->count = 0;
+  group->example_count = 0;
+  group->params = NULL;
+  if(!test->has_config_overflow && test->param_count > 0)
+  {
+    group->params = _gid_arena_alloc(
+      &test->failure_arena,
+      sizeof(GIDParamSpread) * test->param_count);
+    for(size_t i = 0; i < test->param_count; i++)
+    {
+      group->params[i].min_position = SIZE_MAX;
+      group->params[i].max_position = 0;
+      group->params[i].position_mask = 0;
+    }
+  }
+  group->next = NULL;
+  if(test->last_failure_group == NULL)
+    test->first_failure_group = group;
+  else
+    test->last_failure_group->next = group;
+  test->last_failure_group = group;
+  test->failure_group_count++;
+  return group;
+}
+
+/* Keeps a failure as an example of its group if its configuration index is
+ * among the lowest of the group. The examples are copied into buffers of
+ * the largest size, so a later failure with a lower index can replace one
+ * without allocating.
+ * @param test - Pointer to the GIDTest.
+ * @param group - Pointer to the GIDFailureGroup of the failure.
+ * @param failure - Pointer to the GIDTestFailure, which isn't kept. */
+void _gid_add_failure_example(
+  GIDTest* test,
+  GIDFailureGroup* group,
+  const GIDTestFailure* failure)
+{
+  GIDTestFailure* example;
+  if(group->example_count < GID_MAX_FAILURE_EXAMPLES)
+  {
+    example = _gid_arena_alloc(
+      &test->failure_arena,
+      sizeof(GIDTestFailure)
+        + GID_MAX_CONFIGURATION_STRING_LENGTH
+        + GID_MAX_MESSAGE_LENGTH);
+    example->configuration = (char*)(example + 1);
+    example->message =
+      (char*)(example + 1) + GID_MAX_CONFIGURATION_STRING_LENGTH;
+    group->examples[group->example_count++] = example;
+  }
+  else
+  {
+    example = group->examples[GID_MAX_FAILURE_EXAMPLES - 1];
+    if(failure->configuration_index >= example->configuration_index)
+      return;
+  }
+
+  snprintf((char*)example->configuration, GID_MAX_CONFIGURATION_STRING_LENGTH,
+    "%s", failure->configuration);
+  snprintf((char*)example->message, GID_MAX_MESSAGE_LENGTH,
+    "%s", failure->message);
+  example->test_name = failure->test_name;
+  example->configuration_index = failure->configuration_index;
+  example->source_file = failure->source_file;
+  example->line = failure->line;
+  example->step = failure->step;
+  example->next = NULL;
+
+  //The new example is last, so move it into place
+  for(size_t i = group->example_count - 1; i > 0; i--)
+  {
+    GIDTestFailure* prev = group->examples[i - 1];
+    if(prev->configuration_index <= example->configuration_index)
+      break;
+    group->examples[i - 1] = example;
+    group->examples[i] = prev;
+  }
+}
+
+/* Adds failures to the groups of a test (see GIDFailureGroup). The failures
+ * themselves aren't kept, so they can be freed once this returns; only the
+ * groups and their examples are kept, in the GIDArena of the test.
+ * @param test - Pointer to the GIDTest.
+ * @param first - Pointer to the first GIDTestFailure to add, or NULL. Every
+ *        failure that follows it is added too. */
+void _gid_add_test_failures(GIDTest* test, const GIDTestFailure* first)
+{
+  if(first == NULL)
+    return;
+  if(test->failure_positions == NULL)
+  {
+    //The test always has the same parameters, so this is allocated once
+    test->failure_positions = _gid_arena_alloc(
+      &test->failure_arena,
+      sizeof(size_t) * (test->param_count + 1));
+    test->failure_values = _gid_arena_alloc(
+      &test->failure_arena,
+      sizeof(GIDParamValue) * (test->param_count + 1));
+  }
+  size_t* positions = test->failure_positions;
+  GIDParamValue* values = test->failure_values;
+  for(const GIDTestFailure* f = first; f != NULL; f = f->next)
+  {
+    GIDFailureGroup* group = _gid_get_failure_group(test, f);
+    if(group == NULL)
+    {
+      test->ungrouped_failure_count++;
+      continue;
+    }
+    group->count++;
+    _gid_add_failure_example(test, group, f);
+
+    if(group->params == NULL
+      || !_gid_decode_config_index(test, f->configuration_index,
+        positions, values))
+    {
+      continue;
+    }
+    for(size_t i = 0; i < test->param_count; i++)
+    {
+      GIDParamSpread* spread = &group->params[i];
+      if(positions[i] < spread->min_position)
+        spread->min_position = positions[i];
+      if(positions[i] > spread->max_position)
+        spread->max_position = positions[i];
+      if(positions[i] < 64)
+        spread->position_mask |= (uint64_t)1 << positions[i];
+    }
+  }
+}
+
+/* Orders the groups of failures of a test by their first example, and
+ * links the examples of all groups into the list of failures of the test,
+ * ordered by configuration index. This is done when the test finishes.
+ * @param test - Pointer to the GIDTest. */
+void _gid_finish_failure_groups(GIDTest* test)
+{
+  //There are few groups, so an insertion sort is enough
+  GIDFailureGroup* sorted = NULL;
+  GIDFailureGroup* group = test->first_failure_group;
+  while(group != NULL)
+  {
+    GIDFailureGroup* next = group->next;
+    GIDFailureGroup** pos = &sorted;
+    while(*pos != NULL
+      && (*pos)->examples[0]->configuration_index
+        <= group->examples[0]->configuration_index)
+    {
+      pos = &(*pos)->next;
+    }
+    group->next = *pos;
+    *pos = group;
+    group = next;
+  }
+  test->first_failure_group = sorted;
+  test->last_failure_group = sorted;
+  while(test->last_failure_group != NULL
+    && test->last_failure_group->next != NULL)
+  {
+    test->last_failure_group = test->last_failure_group->next;
+  }
+
+  GIDTestFailure* first = NULL;
+  GIDTestFailure** tail = &first;
+  for(group = sorted; group != NULL; group = group->next)
+  {
+    for(size_t i = 0; i < group->example_count; i++)
+    {
+      *tail = group->examples[i];
+      tail = &group->examples[i]->next;
+    }
+  }
+  *tail = NULL;
+  test->first_failure = _gid_sort_test_failures(first);
+  test->last_failure = test->first_failure;
+  while(test->last_failure != NULL && test->last_failure->next != NULL)
+    test->last_failure = test->last_failure->next;
+}
+
+/* Moves the measurement of a run of a Benchmark to the end of a linked list
+ * of GIDBenchmarkResults. Nothing is moved unless the measurement finished
+ * and the run passed.
+ * @param first - Pointer to the first GIDBenchmarkResult of the list.
+ * @param last - Pointer to the last GIDBenchmarkResult of the list.
+ * @param run - Pointer to the GIDTestRun that finished.
+ * @param recordIndex - The index of the record of the run in the binary
+ *        results file, or UINT64_MAX if it has none. */
+void _gid_move_run_benchmark(
+  GIDBenchmarkResult** first,
+  GIDBenchmarkResult** last,
+  const GIDTestRun* run,
+  uint64_t recordIndex)
+{
+  if(!run->benchmark.is_complete || run->run_result != GID_RUN_RESULT_PASSED)
+    return;
+  GIDBenchmarkResult* result = _gid_create_benchmark_result(
+    run->configuration_index,
+    &run->benchmark.stats,
+    recordIndex);
+  if(*first == NULL)
+    *first = result;
+  else
+    (*last)->next = result;
+  *last = result;
+}
+
+/* Sets up the rows of the hardware performance counters of a test, once
+ * its parameters are registered. Each value of each parameter that has at
+ * most GID_MAX_PERF_BREAKDOWN_VALUES values gets a row. The rows and the
+ * sums of the test are allocated from the registration arena.
+ * @param test - Pointer to the GIDTest. */
+void _gid_init_perf_rows(GIDTest* test)
+{
+  GIDArena* arena = &_gid_registration_arena;
+  test->perf_rows = _gid_arena_alloc(
+    arena,
+    sizeof(size_t) * (test->param_count + 1));
+  test->perf_row_count = 1;
+  for(GIDParamBase* param = test->first_param;
+    param != NULL;
+    param = param->next)
+  {
+    size_t valueCount = _gid_param_value_count(param);
+    test->perf_rows[param->slot] = 0;
+    if(valueCount > 1 && valueCount <= GID_MAX_PERF_BREAKDOWN_VALUES)
+    {
+      test->perf_rows[param->slot] = test->perf_row_count;
+      test->perf_row_count += valueCount;
+    }
+  }
+
+  size_t sumsSize =
+    sizeof(double) * test->perf_row_count * GID_PERF_COUNTER_COUNT;
+  test->perf.sums = _gid_arena_alloc(arena, sumsSize);
+  memset(test->perf.sums, 0, sumsSize);
+  test->perf.counts =
+    _gid_arena_alloc(arena, sizeof(uint64_t) * test->perf_row_count);
+  memset(test->perf.counts, 0, sizeof(uint64_t) * test->perf_row_count);
+}
+
+/* Adds counters to a row of a GIDPerfTally.
+ * @param tally - Pointer to the GIDPerfTally.
+ * @param row - The row.
+ * @param values - The value of each counter, indexed by GIDPerfCounter.
+ * @param count - The number of configurations that the values are for. */
+void _gid_add_perf_row(
+  GIDPerfTally* tally,
+  size_t row,
+  const double* values,
+  uint64_t count)
+{
+  for(int i = 0; i < GID_PERF_COUNTER_COUNT; i++)
+    tally->sums[row * GID_PERF_COUNTER_COUNT + i] += values[i];
+  tally->counts[row] += count;
+}
+
+/* Adds the hardware performance counters of a configuration to a
+ * GIDPerfTally, in row zero and in the row of the value of each parameter
+ * that is broken down. Nothing is added unless the counters were measured.
+ * @param test - Pointer to the GIDTest whose rows the tally has.
+ * @param tally - Pointer to the GIDPerfTally. Its arrays are allocated when
+ *        the first configuration is added, unless they already are.
+ * @param configIndex - The index of the configuration.
+ * @param stats - Pointer to the GIDPerfStats of the configuration. */
+void _gid_add_perf_stats(
+  const GIDTest* test,
+  GIDPerfTally* tally,
+  uint64_t configIndex,
+  const GIDPerfStats* stats)
+{
+  if(stats->mask == 0)
+    return;
+  if(tally->sums == NULL)
+  {
+    tally->sums =
+      calloc(test->perf_row_count * GID_PERF_COUNTER_COUNT, sizeof(double));
+    tally->counts = calloc(test->perf_row_count, sizeof(uint64_t));
+  }
+  tally->mask = tally->counts[0] == 0 ? stats->mask : tally->mask & stats->mask;
+
+  double values[GID_PERF_COUNTER_COUNT];
+  for(int i = 0; i < GID_PERF_COUNTER_COUNT; i++)
+    values[i] = (double)stats->values[i];
+  _gid_add_perf_row(tally, 0, values, 1);
+
+  //The position of each parameter is a digit of the index
+  for(const GIDParamBase* param = test->first_param;
+    param != NULL;
+    param = param->next)
+  {
+    uint64_t count = _gid_param_value_count(param);
+    if(count == 0)
+      continue;
+    size_t firstRow = test->perf_rows[param->slot];
+    if(firstRow != 0)
+      _gid_add_perf_row(tally, firstRow + configIndex % count, values, 1);
+    configIndex /= count;
+  }
+}
+
+/* Adds a GIDPerfTally of some of the configurations of a test to the tally
+ * of the test.
+ * @param test - Pointer to the GIDTest.
+ * @param src - Pointer to the GIDPerfTally to add, whose arrays are freed. */
+void _gid_merge_perf_tally(GIDTest* test, GIDPerfTally* src)
+{
+  if(src->sums == NULL)
+    return;
+  if(src->counts[0] > 0)
+  {
+    GIDPerfTally* dst = &test->perf;
+    dst->mask = dst->counts[0] == 0 ? src->mask : dst->mask & src->mask;
+    for(size_t row = 0; row < test->perf_row_count; row++)
+    {
+      _gid_add_perf_row(
+        dst,
+        row,
+        src->sums + row * GID_PERF_COUNTER_COUNT,
+        src->counts[row]);
+    }
+  }
+  free(src->sums);
+  free(src->counts);
+  memset(src, 0, sizeof(GIDPerfTally));
+}
+
+/* Starts measuring a step of a run (see BEGIN_TEST_SUITE). This starts
+ * counting heap allocations, if GID_WRAP_MALLOC is defined, and the hardware
+ * performance counters of the run step, if they are measured.
+ * @param run - Pointer to the GIDTestRun, whose 'step' is the step that is
+ *        starting. */
+void _gid_enter_step(GIDTestRun* run)
+{
+#ifdef GID_WRAP_MALLOC
+  _gid_heap_live_bytes = 0;
+  _gid_heap_stats = &run->heap[run->step];
+#endif
+  if(run->perf_counters != NULL && run->step == GID_STEP_RUN)
+    _gid_start_perf_counters(run->perf_counters);
+}
+
+/* Stops measuring a step of a run, and stores the measurements in the run.
+ * @param run - Pointer to the GIDTestRun, whose 'step' is the step that has
+ *        finished. */
+void _gid_leave_step(GIDTestRun* run)
+{
+  if(run->perf_counters != NULL && run->step == GID_STEP_RUN)
+    _gid_stop_perf_counters(run->perf_counters, &run->perf);
+#ifdef GID_WRAP_MALLOC
+  _gid_heap_stats = NULL;
+#endif
+}
+
+/* Contains a set of similar tests. */
+typedef struct GIDTestSuite
+{
+  /* The name of the test suite. */
+  const char* name;
+
+  /* Pointer to the first GIDTest, or NULL. */
+  GIDTest* first_test;
+
+  /* Pointer to the last GIDTest, or NULL. */
+  GIDTest* last_test;
+
+  /* Identifies the scope that contains the body of the SetUp function, or
+   * zero if the suite has no SetUp function. */
+  int setup_scope;
+
+  /* Identifies the scope that contains the body of the TearDown function, or
+   * zero if the suite has no TearDown function. */
+  int teardown_scope;
+
+  /* Function that runs the test suite, as generated by the
+   * BEGIN_TEST_SUITE and END_TEST_SUITE macros. When the first argument is
+   * NULL, the function registers the tests of the suite. Otherwise it runs
+   * one configuration of the specified GIDTest, recording the result in the
+   * GIDTestRun that is passed as the second argument. */
+  void (*func)(GIDTest* test, GIDTestRun* run);
+
+  /* Pointer to the next GIDTestSuite, if any. */
+  struct GIDTestSuite* next;
+} GIDTestSuite;
+
+/* Creates a test suite in the registration arena.
+ * @param name - The name of the test suite. This isn't copied, so it must be
+ *        a string literal.
+ * @param func - The function that was generated by the BEGIN_TEST_SUITE and
+ *        END_TEST_SUITE macros.
+ * @returns - A pointer to the allocated GIDTestSuite. */
+GIDTestSuite* _gid_create_test_suite(
+  const char* name,
+  void (*func)(GIDTest* test, GIDTestRun* run))
+{
+  GIDTestSuite* suite =
+    _gid_arena_alloc(&_gid_registration_arena, sizeof(GIDTestSuite));
+  suite->name = name;
+  suite->first_test = NULL;
+  suite->last_test = NULL;
+  suite->setup_scope = 0;
+  suite->teardown_scope = 0;
+  suite->func = func;
+  suite->next = NULL;
+  return suite;
+}
+
+/* Gets the scope of a test suite's function that must be executed for a
+ * particular step of a test run.
+ * @param suite - Pointer to the GIDTestSuite that contains the test.
+ * @param test - Pointer to the GIDTest that is running, or NULL if the tests
+ *        of the suite are being registered.
+ * @param step - The GIDTestStep that is about to be executed.
+ * @returns - The scope to jump to. Zero means that no scope needs to be
+ *          executed, unless 'test' is NULL in which case the entire suite
+ *          function is walked to register the tests. */
+int _gid_get_step_scope(
+  const GIDTestSuite* suite,
+  const GIDTest* test,
+  GIDTestStep step)
+{
+  if(test == NULL)
+    return 0;
+
+  switch(step)
+  {
+    case GID_STEP_SETUP:
+      return suite->setup_scope;
+    case GID_STEP_RUN:
+      return test->scope;
+    case GID_STEP_TEARDOWN:
+      return suite->teardown_scope;
+    default:
+      return 0;
+  }
+}
+
+/* Contains the options that control how the tests are run. */
+typedef struct GIDOptions
+{
+  /* The number of threads that run the tests. One means that all tests are
+   * run on the thread that calls gidunit(). */
+  int32_t thread_count;
+
+  /* The number of worker processes that run the tests, or zero to run them
+   * in the process that calls gidunit(). */
+  int32_t process_count;
+
+  /* The zero-based index of the shard that this process runs. */
+  int32_t shard_index;
+
+  /* The number of shards into which the configurations of all tests are
+   * split. One means that this process runs every configuration. */
+  int32_t shard_count;
+
+  /* The strength of the covering arrays to run for tests that don't choose
+   * their own, or zero to run every configuration. */
+  int32_t coverage_strength;
+
+  /* The number of configurations to sample from each test that has more, or
+   * zero to run every configuration (see _gid_select_sample). */
+  uint64_t sample_count;
+
+  /* The time budget of each test, in milliseconds. Once it runs out, the
+   * rest of the configurations of the test are not run. Zero means no
+   * limit. */
+  int32_t time_budget;
+
+  /* The seed of the random order in which configurations are sampled. */
+  uint64_t seed;
+
+  /* The longest time that each configuration of a test that doesn't choose
+   * its own timeout may run, in milliseconds, or zero for no limit. */
+  int32_t timeout;
+
+  /* The time that each measured batch of a Benchmark should take, in
+   * milliseconds. */
+  int32_t benchmark_time;
+
+  /* The path of the file that contains the baseline measurements of the
+   * Benchmarks, or NULL to not compare them with a baseline. */
+  const char* baseline_path;
+
+  /* How much slower than its baseline each configuration of a Benchmark that
+   * doesn't choose its own threshold may be before it fails, as a
+   * percentage. */
+  int32_t regression_threshold;
+
+  /* Non-zero to replace the baseline measurements with the new ones, instead
+   * of comparing them. */
+  int update_baseline;
+
+  /* Non-zero to measure the hardware performance counters of the run step of
+   * each configuration. */
+  int perf_counters;
+
+  /* The most times per second that the progress line is updated, or zero to
+   * only print each test when it finishes. */
+  int32_t progress_rate;
+
+  /* The path of the JUnit XML report to write, or NULL to not write one. */
+  const char* junit_path;
+
+  /* Non-zero to write each configuration as a test case in the JUnit XML
+   * report, instead of each test. */
+  int junit_per_config;
+
+  /* The path of the file to which JSON events are written, or NULL. */
+  const char* events_path;
+
+  /* The file descriptor to which JSON events are written if there is no
+   * events_path, or -1 to not write them. */
+  int events_fd;
+
+  /* The path of the binary results file to write, or NULL to not write
+   * one. */
+  const char* results_path;
+} GIDOptions;
+
+/* The options for the current call to gidunit(). */
+GIDOptions _gid_options;
+
+/* Contains the state of the progress line, which shows the status of the
+ * running test while its configurations run. */
+typedef struct GIDProgress
+{
+  /* Is stdout a terminal? Non-zero means yes. Otherwise (such as when the
+   * output is a log file), there is no progress line, and each test prints
+   * one line when it finishes. */
+  int is_terminal;
+
+  /* The shortest time between updates of the progress line, in
+   * nanoseconds, or zero to not show a progress line. */
+  uint64_t interval;
+
+  /* Measures the time since the progress line was last updated. */
+  GIDTimer timer;
+
+  /* Is the progress line showing (so the next update may have to wait for
+   * the interval)? Non-zero means yes. */
+  int is_showing;
+} GIDProgress;
+
+/* The state of the progress line. */
+GIDProgress _gid_progress;
+
+/* Initializes the progress line, which depends on whether stdout is a
+ * terminal, and on the progress_rate of GIDOptions. */
+void _gid_init_progress()
+{
+#ifdef _WIN32
+  _gid_progress.is_terminal = _isatty(_fileno(stdout));
+#else
+  _gid_progress.is_terminal = isatty(fileno(stdout));
+#endif
+  _gid_progress.interval = 0;
+  if(_gid_progress.is_terminal && _gid_options.progress_rate > 0)
+    _gid_progress.interval = 1000000000 / _gid_options.progress_rate;
+  _gid_progress.is_showing = 0;
+}
+
+/* Clears the current line on stdout. */
+#define _gid_clear_console_line() printf("%c[2K\r", 27)
+
+/* Prints the heading of a section of the report, which is colored on a
+ * terminal.
+ * @param style - The SGR parameters of the colors, such as "30;41".
+ * @param title - The text of the heading. */
+void _gid_print_heading(const char* style, const char* title)
+{
+  if(_gid_progress.is_terminal)
+    printf("\n\033[%sm  %s  \033[0m\n", style, title);
+  else
+    printf("\n  %s  \n", title);
+}
+
+/* Gets the longest time that each configuration of a test may run.
+ * @param test - Pointer to the GIDTest.
+ * @returns - The timeout in milliseconds, or zero for no limit. */
+int32_t _gid_get_timeout(const GIDTest* test)
+{
+  int32_t timeout = test->timeout >= 0 ? test->timeout : _gid_options.timeout;
+  return timeout > 0 ? timeout : 0;
+}
+
+/* Finishes a batch of iterations of a Benchmark, and decides whether to run
+ * another. The first batch has one iteration, and the batch size grows until
+ * a batch takes at least the target time (see the benchmark_time of
+ * GIDOptions). Then batches of that size are measured until the times of
+ * the last GID_BENCHMARK_SAMPLE_COUNT batches agree, and the median of them
+ * is the time per iteration.
+ * @param bench - Pointer to the GIDBenchmark of the current run.
+ * @returns - Non-zero if another batch must be run, which has started. Zero
+ *          means that the measurement is complete. */
+int _gid_next_benchmark_batch(GIDBenchmark* bench)
+{
+  GIDBenchmarkStats* stats = &bench->stats;
+  if(stats->iterations == 0)
+  {
+    stats->iterations = 1;
+    _gid_start_timer(&bench->timer);
+    return 1;
+  }
+
+  uint64_t elapsed = _gid_read_timer(&bench->timer);
+  uint64_t target = (uint64_t)_gid_options.benchmark_time * 1000000;
+  if(!bench->is_calibrated
+    && elapsed < target
+    && stats->iterations < GID_BENCHMARK_MAX_ITERATIONS)
+  {
+    //Aim a bit past the target, but don't grow too quickly from noise
+    uint64_t next = stats->iterations * 100;
+    if(elapsed > 0)
+    {
+      double predicted = 1.2 * stats->iterations * target / elapsed;
+      if(predicted < next)
+        next = (uint64_t)predicted;
+    }
+    if(next <= stats->iterations)
+      next = stats->iterations + 1;
+    stats->iterations =
+      next < GID_BENCHMARK_MAX_ITERATIONS ? next : GID_BENCHMARK_MAX_ITERATIONS;
+    _gid_start_timer(&bench->timer);
+    return 1;
+  }
+  bench->is_calibrated = 1;
+
+  bench->samples[stats->sample_count % GID_BENCHMARK_SAMPLE_COUNT] =
+    (double)elapsed / stats->iterations;
+  stats->sample_count++;
+  if(stats->sample_count >= GID_BENCHMARK_SAMPLE_COUNT)
+  {
+    //Sort the recent samples to find their spread and median
+    double sorted[GID_BENCHMARK_SAMPLE_COUNT];
+    memcpy(sorted, bench->samples, sizeof(sorted));
+    for(size_t i = 1; i < GID_BENCHMARK_SAMPLE_COUNT; i++)
+    {
+      for(size_t j = i; j > 0 && sorted[j - 1] > sorted[j]; j--)
+      {
+        double swap = sorted[j];
+        sorted[j] = sorted[j - 1];
+        sorted[j - 1] = swap;
+      }
+    }
+    double spread = sorted[GID_BENCHMARK_SAMPLE_COUNT - 1] - sorted[0];
+    if(spread <= sorted[0] * GID_BENCHMARK_TOLERANCE
+      || stats->sample_count >= GID_BENCHMARK_MAX_SAMPLE_COUNT)
+    {
+      stats->nanos_per_op = sorted[GID_BENCHMARK_SAMPLE_COUNT / 2];
+      bench->is_complete = 1;
+      return 0;
+    }
+  }
+  _gid_start_timer(&bench->timer);
+  return 1;
+}
+
+/* Pointer to the first GIDTestSuite, or NULL. */
+GIDTestSuite* _gid_first_suite = NULL;
+
+/* Pointer to the last GIDTestSuite, or NULL. */
+GIDTestSuite* _gid_last_suite = NULL;
+
+/* Frees the memory of a test suite's tests that was allocated while they
+ * ran. The suite, its tests and their parameters are in the registration
+ * arena, which _gid_free frees.
+ * @param suite - Pointer to the GIDTestSuite. */
+void _gid_free_suite(GIDTestSuite* suite)
+{
+  GIDTest* cur = suite->first_test;
+  while(cur != NULL)
+  {
+    free(cur->config_indices);
+    _gid_free_arena(&cur->failure_arena);
+    _gid_free_benchmark_results(cur->first_benchmark);
+    cur = cur->next;
+  }
+}
+
+/* Calculates a statistical summary of a particular test suite.
+ * @param suite - Pointer to the GIDTestSuite from which to obtain the summary.
+ * @param totalTests - Pointer to an integer that will be assigned to the total
+ *        number of tests in the suite (not counting each configuration).
+ * @param passTests - Pointer to an integer that will be assigned to the number
+ *        of tests in the suite that had no failures under any configuration.
+ * @param failTests - Pointer to an integer that will be assigned to the number
+ *        of tests that had at least one failure in any configuration.
+ * @param totalConfigs - The total number of configurations of all tests.
+ * @param passConfigs - The number of passing configurations.
+ * @param skipConfigs - The number of configurations that were skipped. */
+void _gid_get_suite_summary(
+  const GIDTestSuite* suite,
+  int32_t* totalTests,
+  int32_t* passTests,
+  int32_t* failTests,
+  uint64_t* totalConfigs,
+  uint64_t* passConfigs,
+  uint64_t* skipConfigs)
+{
+  *totalTests = 0;
+  *passTests = 0;
+  *failTests = 0;
+  *totalConfigs = 0;
+  *passConfigs = 0;
+  *skipConfigs = 0;
+
+  GIDTest* test = suite->first_test;
+  while(test != NULL)
+  {
+    if(test->total_config_count == 0)
+    {
+      test = test->next;
+      continue;//Not in this shard
+    }
+    *totalTests = *totalTests + 1;
+    if(test->status == GID_TEST_PASSED)
+      *passTests = *passTests + 1;
+    if(test->status == GID_TEST_FAILED)
+      *failTests = *failTests + 1;
+    *totalConfigs += test->total_config_count;
+    *passConfigs += test->pass_config_count;
+    *skipConfigs += test->skip_config_count;
+    test = test->next;
+  }
+}
+
+/* Writes a duration with a unit that keeps it short, such as '1.25ms' or
+ * '840ns', with three significant digits.
+ * @param nanos - The duration, in nanoseconds.
+ * @param dst - The destination string buffer.
+ * @param dstSize - The number of chars allocated for 'dst'. */
+void _gid_format_duration(double nanos, char* dst, size_t dstSize)
+{
+  const char* unit = "ns";
+  double value = nanos;
+  if(nanos >= 1000000000)
+  {
+    unit = "s";
+    value = nanos / 1e9;
+  }
+  else if(nanos >= 1000000)
+  {
+    unit = "ms";
+    value = nanos / 1e6;
+  }
+  else if(nanos >= 1000)
+  {
+    unit = "us";
+    value = nanos / 1e3;
+  }
+  int decimals = value < 10 ? 2 : value < 100 ? 1 : 0;
+  snprintf(dst, dstSize, "%.*f%s", decimals, value, unit);
+}
+
+/* Writes a quantity with a metric prefix that keeps it short, such as
+ * '8.10 Mops/s', '1.25 GB/s' or '3.40 M', with three significant digits.
+ * @param value - The quantity.
+ * @param unit - The unit, such as 'B/s' for bytes per second, or an empty
+ *        string for a plain count.
+ * @param dst - The destination string buffer.
+ * @param dstSize - The number of chars allocated for 'dst'. */
+void _gid_format_metric(
+  double value,
+  const char* unit,
+  char* dst,
+  size_t dstSize)
+{
+  const char* prefixes[] = { "", "k", "M", "G", "T", "P" };
+  size_t prefix = 0;
+  while(value >= 1000 && prefix < 5)
+  {
+    value /= 1000;
+    prefix++;
+  }
+  int decimals = value < 10 ? 2 : value < 100 ? 1 : 0;
+  if(prefix == 0 && value == (uint64_t)value)
+    decimals = 0;//A whole count
+  snprintf(dst, dstSize, "%.*f%s%s%s",
+    decimals,
+    value,
+    prefix > 0 || unit[0] != '\0' ? " " : "",
+    prefixes[prefix],
+    unit);
+}
+
+/* Gets the string representation of a configuration of a test, which
+ * includes the names and values of each parameter.
+ * @param test - Pointer to the GIDTest.
+ * @param index - The zero-based index of the configuration.
+ * @param positions - Buffer for the position of each parameter, with room
+ *        for one more than the 'param_count' of the test.
+ * @param values - Buffer for the value of each parameter, of the same size.
+ * @param dst - The destination string buffer.
+ * @param dstSize - The number of chars allocated for 'dst'. */
+void _gid_get_config_string(
+  const GIDTest* test,
+  uint64_t index,
+  size_t* positions,
+  GIDParamValue* values,
+  char* dst,
+  size_t dstSize)
+{
+  _gid_decode_config_index(test, index, positions, values);
+  _gid_get_params_string(test->first_param, positions, dst, (int64_t)dstSize);
+}
+
+/* Prints the measurement of each configuration of each Benchmark that was
+ * run, in the order that the configurations are numbered. */
+void _gid_print_benchmark_results()
+{
+  int hasHeader = 0;
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      if(test->first_benchmark == NULL)
+        continue;
+      if(!hasHeader)
+      {
+        _gid_print_heading("30;46", "Benchmarks");
+        hasHeader = 1;
+      }
+
+      size_t* positions = malloc(sizeof(size_t) * (test->param_count + 1));
+      GIDParamValue* values =
+        malloc(sizeof(GIDParamValue) * (test->param_count + 1));
+      for(GIDBenchmarkResult* result = test->first_benchmark;
+        result != NULL;
+        result = result->next)
+      {
+        char config[GID_MAX_CONFIGURATION_STRING_LENGTH];
+        _gid_get_config_string(
+          test,
+          result->configuration_index,
+          positions,
+          values,
+          config,
+          GID_MAX_CONFIGURATION_STRING_LENGTH);
+
+        const GIDBenchmarkStats* stats = &result->stats;
+        char perOp[32];
+        _gid_format_duration(stats->nanos_per_op, perOp, sizeof(perOp));
+        printf("%s > %s(%s)\t%s/op",
+          suite->name,
+          test->name,
+          config,
+          perOp);
+        //A body that was optimized away can take no measurable time at all
+        if(stats->nanos_per_op > 0)
+        {
+          char opRate[32];
+          _gid_format_metric(
+            1e9 / stats->nanos_per_op,
+            "ops/s",
+            opRate,
+            sizeof(opRate));
+          printf("\t%s", opRate);
+        }
+        if(stats->bytes_per_op > 0 && stats->nanos_per_op > 0)
+        {
+          char byteRate[32];
+          _gid_format_metric(
+            stats->bytes_per_op * 1e9 / stats->nanos_per_op,
+            "B/s",
+            byteRate,
+            sizeof(byteRate));
+          printf("\t%s", byteRate);
+        }
+        printf("\t[%u batches of %"PRIu64" iterations]\n",
+          stats->sample_count,
+          stats->iterations);
+      }
+      free(positions);
+      free(values);
+    }
+  }
+}
+
+/* Prints one row of the hardware performance counters of a test, as the
+ * average of each counter over a set of configurations.
+ * @param label - The label of the row, such as the value of a parameter.
+ * @param sums - The sum of each counter over the configurations, indexed by
+ *        GIDPerfCounter.
+ * @param count - The number of configurations.
+ * @param mask - A bit for each GIDPerfCounter that was measured. */
+void _gid_print_perf_row(
+  const char* label,
+  const double* sums,
+  uint64_t count,
+  uint32_t mask)
+{
+  printf("  %s", label);
+  if(count == 0)
+  {
+    printf("\tnot run\n");
+    return;
+  }
+  uint32_t ipc = (1u << GID_PERF_CYCLES) | (1u << GID_PERF_INSTRUCTIONS);
+  uint32_t missRate =
+    (1u << GID_PERF_BRANCHES) | (1u << GID_PERF_BRANCH_MISSES);
+  for(int i = 0; i < GID_PERF_COUNTER_COUNT; i++)
+  {
+    if((mask & (1u << i)) == 0)
+      continue;
+    char value[32];
+    _gid_format_metric(sums[i] / count, "", value, sizeof(value));
+    printf("\t%s %s", value, _gid_perf_counter_names[i]);
+
+    //Ratios that explain the counts
+    if(i == GID_PERF_INSTRUCTIONS
+      && (mask & ipc) == ipc
+      && sums[GID_PERF_CYCLES] > 0)
+    {
+      printf(" (%.2f IPC)", sums[i] / sums[GID_PERF_CYCLES]);
+    }
+    else if(i == GID_PERF_BRANCH_MISSES
+      && (mask & missRate) == missRate
+      && sums[GID_PERF_BRANCHES] > 0)
+    {
+      printf(" (%.2f%%)", 100 * sums[i] / sums[GID_PERF_BRANCHES]);
+    }
+  }
+  printf("\n");
+}
+
+/* Prints the hardware performance counters of each test whose counters were
+ * measured (see the GID_PERF_COUNTERS option). Each test has a row with the
+ * average of each counter over all of its configurations, and a row for
+ * each value of each parameter that has at most
+ * GID_MAX_PERF_BREAKDOWN_VALUES values, with the average over the
+ * configurations that have that value. */
+void _gid_print_perf_counters()
+{
+  int hasHeader = 0;
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      const GIDPerfTally* perf = &test->perf;
+      if(perf->counts == NULL || perf->counts[0] == 0)
+        continue;
+      if(!hasHeader)
+      {
+        _gid_print_heading("30;46", "Performance Counters");
+        printf("Each row is the average of the run step of its "
+          "configurations.\n");
+        hasHeader = 1;
+      }
+
+      printf("%s > %s\n", suite->name, test->name);
+      char label[GID_MAX_CONFIGURATION_STRING_LENGTH];
+      snprintf(
+        label,
+        sizeof(label),
+        "all %"PRIu64" configurations",
+        perf->counts[0]);
+      _gid_print_perf_row(label, perf->sums, perf->counts[0], perf->mask);
+      for(GIDParamBase* param = test->first_param;
+        param != NULL;
+        param = param->next)
+      {
+        if(test->perf_rows[param->slot] == 0)
+          continue;
+        size_t valueCount = _gid_param_value_count(param);
+        for(size_t position = 0; position < valueCount; position++)
+        {
+          int len = snprintf(label, sizeof(label), "%s=", param->name);
+          if(len >= 0 && (size_t)len < sizeof(label))
+          {
+            _gid_param_get_value_string(
+              param,
+              position,
+              label + len,
+              sizeof(label) - len);
+          }
+          size_t row = test->perf_rows[param->slot] + position;
+          _gid_print_perf_row(
+            label,
+            perf->sums + row * GID_PERF_COUNTER_COUNT,
+            perf->counts[row],
+            perf->mask);
+        }
+      }
+    }
+  }
+}
+
+/* Prints the heap allocations of each test that allocated memory, which are
+ * only counted when GID_WRAP_MALLOC is defined. Each step has a row with the
+ * averages over the configurations, and the configurations that made the
+ * most allocations and had the highest peak are shown. */
+void _gid_print_heap_allocations()
+{
+  const char* stepNames[3] = { "setup", "run", "teardown" };
+  int hasHeader = 0;
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      const GIDHeapTally* heap = &test->heap;
+      if(_gid_get_heap_alloc_count(heap) == 0 || test->run_config_count == 0)
+        continue;
+      if(!hasHeader)
+      {
+        _gid_print_heading("30;46", "Heap Allocations");
+        printf("Each step is the average of the configurations that were "
+          "run.\n");
+        hasHeader = 1;
+      }
+
+      printf("%s > %s\n", suite->name, test->name);
+      for(int i = 0; i < 3; i++)
+      {
+        char count[32];
+        char bytes[32];
+        char peak[32];
+        _gid_format_metric(
+          (double)heap->steps[i].alloc_count / test->run_config_count,
+          "",
+          count,
+          sizeof(count));
+        _gid_format_metric(
+          (double)heap->steps[i].alloc_bytes / test->run_config_count,
+          "B",
+          bytes,
+          sizeof(bytes));
+        _gid_format_metric(
+          (double)heap->steps[i].peak_bytes / test->run_config_count,
+          "B",
+          peak,
+          sizeof(peak));
+        printf("  %s\t%s allocs\t%s\tpeak %s\n",
+          stepNames[i],
+          count,
+          bytes,
+          peak);
+      }
+
+      size_t* positions = malloc(sizeof(size_t) * (test->param_count + 1));
+      GIDParamValue* values =
+        malloc(sizeof(GIDParamValue) * (test->param_count + 1));
+      char config[GID_MAX_CONFIGURATION_STRING_LENGTH];
+      char amount[32];
+      _gid_get_config_string(
+        test,
+        heap->max_alloc_index,
+        positions,
+        values,
+        config,
+        GID_MAX_CONFIGURATION_STRING_LENGTH);
+      _gid_format_metric(
+        (double)heap->max_alloc_count,
+        "",
+        amount,
+        sizeof(amount));
+      printf("  most allocations\t%s in %s(%s)\n", amount, test->name, config);
+      _gid_get_config_string(
+        test,
+        heap->max_peak_index,
+        positions,
+        values,
+        config,
+        GID_MAX_CONFIGURATION_STRING_LENGTH);
+      _gid_format_metric(
+        (double)heap->max_peak_bytes,
+        "B",
+        amount,
+        sizeof(amount));
+      printf("  highest peak\t%s in %s(%s)\n", amount, test->name, config);
+      free(positions);
+      free(values);
+    }
+  }
+}
+
+/* Contains the baseline measurement of one configuration of a Benchmark,
+ * which later runs are compared with (see _gid_check_baseline). */
+typedef struct GIDBaseline
+{
+  /* Identifies the configuration, as 'suite > test(configuration)'. */
+  char* key;
+
+  /* The time of one iteration, in nanoseconds. */
+  double nanos_per_op;
+
+  /* Pointer to the next GIDBaseline, if any. */
+  struct GIDBaseline* next;
+} GIDBaseline;
+
+/* Pointer to the first GIDBaseline that was loaded or added, or NULL. */
+GIDBaseline* _gid_first_baseline = NULL;
+
+/* Pointer to the last GIDBaseline that was loaded or added, or NULL. */
+GIDBaseline* _gid_last_baseline = NULL;
+
+/* The baselines, in an open-addressing hash table of their keys whose empty
+ * entries are NULL, so finding one doesn't compare it with all of them. */
+GIDBaseline** _gid_baseline_entries = NULL;
+
+/* The number of entries in _gid_baseline_entries, which is a power of two. */
+size_t _gid_baseline_capacity = 0;
+
+/* The number of baselines in _gid_baseline_entries. */
+size_t _gid_baseline_count = 0;
+
+/* Have any baselines been added or changed since they were loaded? Non-zero
+ * means yes, so the baseline file must be saved. */
+int _gid_is_baseline_changed = 0;
+
+/* Gets the position in _gid_baseline_entries at which to look for a key
+ * first. The table must not be empty.
+ * @param key - The key of the configuration.
+ * @returns - The position of the entry. */
+size_t _gid_get_baseline_pos(const char* key)
+{
+  uint64_t hash = _gid_hash_chars(_GID_HASH_BASIS, key, strlen(key));
+  return hash & (_gid_baseline_capacity - 1);
+}
+
+/* Adds a baseline measurement. There must not be a baseline with the same
+ * key yet (see _gid_find_baseline).
+ * @param key - The key of the configuration, which the GIDBaseline takes
+ *        ownership of.
+ * @param nanosPerOp - The time of one iteration, in nanoseconds.
+ * @returns - Pointer to the new GIDBaseline. */
+GIDBaseline* _gid_add_baseline(char* key, double nanosPerOp)
+{
+  if((_gid_baseline_count + 1) * 2 > _gid_baseline_capacity)
+  {
+    //Grow the table, so it is never more than half full
+    GIDBaseline** old = _gid_baseline_entries;
+    size_t oldCapacity = _gid_baseline_capacity;
+    _gid_baseline_capacity = oldCapacity == 0 ? 64 : oldCapacity * 2;
+    _gid_baseline_entries =
+      calloc(_gid_baseline_capacity, sizeof(GIDBaseline*));
+    for(size_t i = 0; i < oldCapacity; i++)
+    {
+      if(old[i] == NULL)
+        continue;
+      size_t pos = _gid_get_baseline_pos(old[i]->key);
+      while(_gid_baseline_entries[pos] != NULL)
+        pos = (pos + 1) & (_gid_baseline_capacity - 1);
+      _gid_baseline_entries[pos] = old[i];
+    }
+    free(old);
+  }
+
+  GIDBaseline* baseline = malloc(sizeof(GIDBaseline));
+  baseline->key = key;
+  baseline->nanos_per_op = nanosPerOp;
+  baseline->next = NULL;
+  if(_gid_last_baseline == NULL)
+    _gid_first_baseline = baseline;
+  else
+    _gid_last_baseline->next = baseline;
+  _gid_last_baseline = baseline;
+
+  size_t pos = _gid_get_baseline_pos(key);
+  while(_gid_baseline_entries[pos] != NULL)
+    pos = (pos + 1) & (_gid_baseline_capacity - 1);
+  _gid_baseline_entries[pos] = baseline;
+  _gid_baseline_count++;
+  return baseline;
+}
+
+/* Finds the baseline measurement of a configuration.
+ * @param key - The key of the configuration.
+ * @returns - Pointer to the GIDBaseline, or NULL if there is none. */
+GIDBaseline* _gid_find_baseline(const char* key)
+{
+  if(_gid_baseline_capacity == 0)
+    return NULL;
+  size_t pos = _gid_get_baseline_pos(key);
+  while(_gid_baseline_entries[pos] != NULL)
+  {
+    GIDBaseline* baseline = _gid_baseline_entries[pos];
+    if(strcmp(baseline->key, key) == 0)
+      return baseline;
+    pos = (pos + 1) & (_gid_baseline_capacity - 1);
+  }
+  return NULL;
+}
+
+/* Frees the baseline measurements. */
+void _gid_free_baselines()
+{
+  GIDBaseline* baseline = _gid_first_baseline;
+  while(baseline != NULL)
+  {
+    GIDBaseline* next = baseline->next;
+    free(baseline->key);
+    free(baseline);
+    baseline = next;
+  }
+  _gid_first_baseline = NULL;
+  _gid_last_baseline = NULL;
+  free(_gid_baseline_entries);
+  _gid_baseline_entries = NULL;
+  _gid_baseline_capacity = 0;
+  _gid_baseline_count = 0;
+  _gid_is_baseline_changed = 0;
+}
+
+/* Loads the baseline measurements from the file of the baseline_path of
+ * GIDOptions. Each line of the file is the time of one iteration in
+ * nanoseconds, a tab, and the key of the configuration, in which newlines
+ * and backslashes are escaped with a backslash. Empty lines and lines that
+ * start with '#' are ignored. Nothing is loaded if the file doesn't exist
+ * yet. */
+void _gid_load_baselines()
+{
+  FILE* file = fopen(_gid_options.baseline_path, "rb");
+  if(file == NULL)
+    return;
+
+  size_t size = 0;
+  size_t capacity = 4096;
+  char* text = malloc(capacity);
+  size_t count;
+  while((count = fread(text + size, 1, capacity - size - 1, file)) > 0)
+  {
+    size += count;
+    if(capacity - size - 1 == 0)
+    {
+      capacity *= 2;
+      text = realloc(text, capacity);
+    }
+  }
+  fclose(file);
+  text[size] = '\0';
+
+  char* line = text;
+  while(*line != '\0')
+  {
+    char* end = strchr(line, '\n');
+    if(end == NULL)
+      end = line + strlen(line);
+    char* next = *end == '\0' ? end : end + 1;
+    if(end > line && end[-1] == '\r')
+      end--;
+    *end = '\0';
+
+    char* tab = NULL;
+    double nanosPerOp = 0;
+    if(line[0] != '#' && line[0] != '\0')
+    {
+      nanosPerOp = strtod(line, &tab);
+      if(tab == line || *tab != '\t')
+        tab = NULL;
+    }
+    if(tab != NULL)
+    {
+      char* key = malloc(end - tab);
+      size_t len = 0;
+      for(const char* c = tab + 1; *c != '\0'; c++)
+      {
+        if(*c == '\\' && c[1] == 'n')
+        {
+          key[len++] = '\n';
+          c++;
+        }
+        else if(*c == '\\' && c[1] == '\\')
+        {
+          key[len++] = '\\';
+          c++;
+        }
+        else
+          key[len++] = *c;
+      }
+      key[len] = '\0';
+      if(_gid_find_baseline(key) == NULL)
+        _gid_add_baseline(key, nanosPerOp);
+      else
+        free(key);
+    }
+    line = next;
+  }
+  free(text);
+}
+
+/* Saves the baseline measurements to the file of the baseline_path of
+ * GIDOptions, in the format that _gid_load_baselines reads.
+ * @returns - Non-zero if the file was written, otherwise zero. */
+int _gid_save_baselines()
+{
+  FILE* file = fopen(_gid_options.baseline_path, "wb");
+  if(file == NULL)
+    return 0;
+
+  fprintf(file, "# GIDUnit benchmark baseline. Each line is the time of one "
+    "iteration in\n# nanoseconds, a tab, and 'suite > test(configuration)'.\n");
+  for(GIDBaseline* baseline = _gid_first_baseline;
+    baseline != NULL;
+    baseline = baseline->next)
+  {
+    fprintf(file, "%.6g\t", baseline->nanos_per_op);
+    for(const char* c = baseline->key; *c != '\0'; c++)
+    {
+      if(*c == '\n')
+        fputs("\\n", file);
+      else if(*c == '\\')
+        fputs("\\\\", file);
+      else
+        fputc(*c, file);
+    }
+    fputc('\n', file);
+  }
+  return fclose(file) == 0;
+}
+
+/* Compares the measurement of each configuration of a Benchmark with its
+ * baseline (see _gid_load_baselines). A configuration that is slower than its
+ * baseline by more than the regression threshold fails, and one that has no
+ * baseline yet is added to the baselines. If the update_baseline of
+ * GIDOptions is set, the baselines are replaced instead.
+ * @param suite - Pointer to the GIDTestSuite that contains the test.
+ * @param test - Pointer to the GIDTest, whose runs have all finished.
+ * @param arena - Pointer to the GIDArena from which to allocate the failures
+ *        of the configurations that regressed.
+ * @returns - Pointer to the GIDTestFailure of the first configuration that
+ *          regressed, followed by the others, or NULL. */
+GIDTestFailure* _gid_check_baseline(
+  const GIDTestSuite* suite,
+  GIDTest* test,
+  GIDArena* arena)
+{
+  if(_gid_options.baseline_path == NULL || test->first_benchmark == NULL)
+    return NULL;
+
+  int32_t threshold = test->regression_threshold >= 0
+    ? test->regression_threshold
+    : _gid_options.regression_threshold;
+  GIDTestFailure* first = NULL;
+  GIDTestFailure** tail = &first;
+  size_t* positions = malloc(sizeof(size_t) * (test->param_count + 1));
+  GIDParamValue* values =
+    malloc(sizeof(GIDParamValue) * (test->param_count + 1));
+  for(GIDBenchmarkResult* result = test->first_benchmark;
+    result != NULL;
+    result = result->next)
+  {
+    char config[GID_MAX_CONFIGURATION_STRING_LENGTH];
+    _gid_get_config_string(
+      test,
+      result->configuration_index,
+      positions,
+      values,
+      config,
+      GID_MAX_CONFIGURATION_STRING_LENGTH);
+    size_t keySize =
+      strlen(suite->name) + strlen(test->name) + strlen(config) + 6;
+    char* key = malloc(keySize);
+    snprintf(key, keySize, "%s > %s(%s)", suite->name, test->name, config);
+
+    double nanosPerOp = result->stats.nanos_per_op;
+    GIDBaseline* baseline = _gid_find_baseline(key);
+    if(baseline == NULL)
+    {
+      _gid_add_baseline(key, nanosPerOp);
+      _gid_is_baseline_changed = 1;
+      continue;
+    }
+    free(key);
+
+    if(_gid_options.update_baseline)
+    {
+      baseline->nanos_per_op = nanosPerOp;
+      _gid_is_baseline_changed = 1;
+    }
+    else if(baseline->nanos_per_op > 0
+      && nanosPerOp > baseline->nanos_per_op * (1 + threshold / 100.0))
+    {
+      char current[32];
+      char previous[32];
+      char message[GID_MAX_MESSAGE_LENGTH];
+      _gid_format_duration(nanosPerOp, current, sizeof(current));
+      _gid_format_duration(baseline->nanos_per_op, previous, sizeof(previous));
+      snprintf(message, GID_MAX_MESSAGE_LENGTH,
+        "ns/op %.2fx slower than baseline (%s/op, baseline %s/op, "
+        "threshold %i%%).",
+        nanosPerOp / baseline->nanos_per_op,
+        current,
+        previous,
+        threshold);
+
+      GIDTestFailure* failure = _gid_create_test_failure(
+        arena,
+        test->name,
+        config,
+        result->configuration_index,
+        message,
+        test->source_file,
+        test->line,
+        GID_STEP_RUN);
+      *tail = failure;
+      tail = &failure->next;
+      test->pass_config_count--;
+    }
+  }
+  free(positions);
+  free(values);
+  return first;
+}
+
+/* Gets the largest number of parameters of any test in any suite.
+ * @returns - The largest 'param_count' of a GIDTest. */
+size_t _gid_get_max_param_count()
+{
+  size_t maxParamCount = 0;
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      if(test->param_count > maxParamCount)
+        maxParamCount = test->param_count;
+    }
+  }
+  return maxParamCount;
+}
+
+/* Contains the state of the JUnit XML report (see the junit_path of
+ * GIDOptions). Each test case is written as soon as its result is known, so
+ * the report never has to be held in memory. */
+typedef struct GIDJUnitReport
+{
+  /* The file of the report, or NULL if no report is written. */
+  FILE* file;
+
+  /* Non-zero if each configuration is written as a test case, instead of
+   * each test. */
+  int is_per_config;
+
+  /* Pointer to the GIDTestSuite whose test cases are being written. */
+  const GIDTestSuite* suite;
+
+  /* Buffer for the position of each parameter of a configuration that is
+   * written, with room for the test that has the most parameters. */
+  size_t* positions;
+
+  /* Buffer for the value of each parameter, of the same size. */
+  GIDParamValue* values;
+} GIDJUnitReport;
+
+/* The JUnit XML report. When the tests run in parallel, this is protected by
+ * the lock of the GIDPool. */
+GIDJUnitReport _gid_junit;
+
+/* Writes a string to an XML file, escaping the characters that XML doesn't
+ * allow as they are. Control characters that XML 1.0 can't represent at all
+ * are written as '?'.
+ * @param file - The file to write to.
+ * @param str - The string to write. */
+void _gid_write_xml_string(FILE* file, const char* str)
+{
+  for(const char* c = str; *c != '\0'; c++)
+  {
+    switch(*c)
+    {
+      case '&':
+        fputs("&amp;", file);
+        break;
+      case '<':
+        fputs("&lt;", file);
+        break;
+      case '>':
+        fputs("&gt;", file);
+        break;
+      case '"':
+        fputs("&quot;", file);
+        break;
+      case '\'':
+        fputs("&apos;", file);
+        break;
+      case '\n':
+        fputs("&#10;", file);
+        break;
+      case '\r':
+        fputs("&#13;", file);
+        break;
+      case '\t':
+        fputs("&#9;", file);
+        break;
+      default:
+        fputc((unsigned char)*c < 0x20 ? '?' : *c, file);
+        break;
+    }
+  }
+}
+
+/* Opens the JUnit XML report at the junit_path of GIDOptions, if it is set,
+ * and writes its header. This must be done after the tests are registered.
+ * @returns - Zero if the report couldn't be opened, otherwise non-zero. */
+int _gid_open_junit_report()
+{
+  memset(&_gid_junit, 0, sizeof(GIDJUnitReport));
+  if(_gid_options.junit_path == NULL)
+    return 1;
+  _gid_junit.file = fopen(_gid_options.junit_path, "wb");
+  if(_gid_junit.file == NULL)
+    return 0;
+
+  size_t maxParamCount = _gid_get_max_param_count();
+  _gid_junit.is_per_config = _gid_options.junit_per_config;
+  _gid_junit.positions = malloc(sizeof(size_t) * (maxParamCount + 1));
+  _gid_junit.values = malloc(sizeof(GIDParamValue) * (maxParamCount + 1));
+  fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n",
+    _gid_junit.file);
+  return 1;
+}
+
+/* Writes the end of the JUnit XML report, if one is open, and closes it.
+ * @returns - Zero if the report couldn't be written, otherwise non-zero. */
+int _gid_close_junit_report()
+{
+  if(_gid_junit.file == NULL)
+    return 1;
+  fputs("</testsuites>\n", _gid_junit.file);
+  int ret = !ferror(_gid_junit.file);
+  if(fclose(_gid_junit.file) != 0)
+    ret = 0;
+  free(_gid_junit.positions);
+  free(_gid_junit.values);
+  memset(&_gid_junit, 0, sizeof(GIDJUnitReport));
+  return ret;
+}
+
+/* Starts the element of a test suite in the JUnit XML report. The counts of
+ * tests and failures aren't known until the suite has finished, so they are
+ * left out, and readers count the test cases instead.
+ * @param suite - Pointer to the GIDTestSuite that is about to run. */
+void _gid_begin_junit_suite(const GIDTestSuite* suite)
+{
+  if(_gid_junit.file == NULL)
+    return;
+  _gid_junit.suite = suite;
+  fputs("  <testsuite name=\"", _gid_junit.file);
+  _gid_write_xml_string(_gid_junit.file, suite->name);
+  fputs("\">\n", _gid_junit.file);
+}
+
+/* Ends the element of the test suite in the JUnit XML report. */
+void _gid_end_junit_suite()
+{
+  if(_gid_junit.file == NULL)
+    return;
+  fputs("  </testsuite>\n", _gid_junit.file);
+  _gid_junit.suite = NULL;
+}
+
+/* Writes a test case to the JUnit XML report, if one is open. All of the
+ * failures are written in one failure element, whose message is that of the
+ * first failure, since most readers only show one.
+ * @param test - Pointer to the GIDTest.
+ * @param config - The configuration string, or NULL if the test case is the
+ *        whole test.
+ * @param runtime - The runtime of the test case, in nanoseconds.
+ * @param result - The GIDRunResult of the test case.
+ * @param first - Pointer to the first GIDTestFailure of the test case, or
+ *        NULL.
+ * @param end - Pointer to the GIDTestFailure just past the last one, or NULL
+ *        for the end of the list. */
+void _gid_write_junit_case(
+  const GIDTest* test,
+  const char* config,
+  uint64_t runtime,
+  GIDRunResult result,
+  const GIDTestFailure* first,
+  const GIDTestFailure* end)
+{
+  const char* stepNames[3] = { "setup", "run", "teardown" };
+  FILE* file = _gid_junit.file;
+  if(file == NULL)
+    return;
+
+  fputs("    <testcase classname=\"", file);
+  _gid_write_xml_string(file, _gid_junit.suite->name);
+  fputs("\" name=\"", file);
+  _gid_write_xml_string(file, test->name);
+  if(config != NULL)
+  {
+    fputc('(', file);
+    _gid_write_xml_string(file, config);
+    fputc(')', file);
+  }
+  fprintf(file, "\" time=\"%.6f\"", runtime / 1e9);
+  int isSkipped = result == GID_RUN_RESULT_SKIPPED
+    || result == GID_RUN_RESULT_PENDING;
+  if(first == end && !isSkipped)
+  {
+    fputs("/>\n", file);
+    return;
+  }
+
+  fputs(">\n", file);
+  if(first != end)
+  {
+    fputs("      <failure message=\"", file);
+    _gid_write_xml_string(file, first->message);
+    fprintf(file, "\" type=\"%s\">", stepNames[first->step]);
+    for(const GIDTestFailure* f = first; f != end; f = f->next)
+    {
+      fprintf(file, "%s:%i (%s): ",
+        f->source_file,
+        f->line,
+        stepNames[f->step]);
+      _gid_write_xml_string(file, f->message);
+      fprintf(file, "\n  configuration %"PRIu64": ",
+        f->configuration_index);
+      _gid_write_xml_string(file, f->configuration);
+      fputc('\n', file);
+    }
+    fputs("</failure>\n", file);
+  }
+  else
+  {
+    fputs("      <skipped/>\n", file);
+  }
+  fputs("    </testcase>\n", file);
+}
+
+/* Writes a run of a configuration as a test case to the JUnit XML report, if
+ * each configuration is written as a test case (see the junit_per_config of
+ * GIDOptions).
+ * @param test - Pointer to the GIDTest.
+ * @param index - The zero-based index of the configuration.
+ * @param result - The GIDRunResult of the run.
+ * @param runtime - The runtime of the run, in nanoseconds.
+ * @param failures - Pointer to the first GIDTestFailure of the run, which
+ *        is followed only by the other failures of the run, or NULL. */
+void _gid_write_junit_run(
+  const GIDTest* test,
+  uint64_t index,
+  GIDRunResult result,
+  uint64_t runtime,
+  const GIDTestFailure* failures)
+{
+  if(!_gid_junit.is_per_config)
+    return;
+  char config[GID_MAX_CONFIGURATION_STRING_LENGTH];
+  _gid_get_config_string(
+    test,
+    index,
+    _gid_junit.positions,
+    _gid_junit.values,
+    config,
+    GID_MAX_CONFIGURATION_STRING_LENGTH);
+  _gid_write_junit_case(test, config, runtime, result, failures, NULL);
+}
+
+/* Contains the state of the stream of JSON events (see the events_path and
+ * events_fd of GIDOptions). Each event is one JSON object on its own line.
+ * Events are formatted straight into a buffer that is allocated once, and
+ * written to the file descriptor when the buffer fills up, when a test
+ * finishes, or once a second, so they can be read while the tests run. */
+typedef struct GIDEventStream
+{
+  /* Is the stream open? Non-zero means yes. */
+  int is_open;
+
+  /* The file descriptor to which events are written. */
+  int fd;
+
+  /* The file that was opened for the stream, or NULL if the stream writes to
+   * a file descriptor that was given in the options. */
+  FILE* file;
+
+  /* Pointer to the GIDTestSuite that is running, or NULL. */
+  const GIDTestSuite* suite;
+
+  /* Measures the time since the buffer was last written. */
+  GIDTimer flush_timer;
+
+  /* Buffer for the position of each parameter of a configuration whose
+   * result is written, with room for the test that has the most
+   * parameters. */
+  size_t* positions;
+
+  /* Buffer for the value of each parameter, of the same size. */
+  GIDParamValue* values;
+
+  /* The number of chars in 'buffer' that haven't been written yet. */
+  size_t size;
+
+  /* The events that haven't been written yet. */
+  char buffer[GID_EVENT_BUFFER_SIZE];
+} GIDEventStream;
+
+/* The stream of JSON events. When the tests run in parallel, this is
+ * protected by the lock of the GIDPool. */
+GIDEventStream _gid_events;
+
+/* Writes the buffered events to the file descriptor of the stream. If this
+ * fails, the stream stops writing, but the tests keep running. */
+void _gid_flush_events()
+{
+  size_t pos = 0;
+  while(pos < _gid_events.size && _gid_events.fd >= 0)
+  {
+#ifdef _WIN32
+    int written = _write(
+      _gid_events.fd,
+      _gid_events.buffer + pos,
+      (unsigned int)(_gid_events.size - pos));
+#else
+    ssize_t written = write(
+      _gid_events.fd,
+      _gid_events.buffer + pos,
+      _gid_events.size - pos);
+    if(written < 0 && errno == EINTR)
+      continue;
+#endif
+    if(written <= 0)
+      _gid_events.fd = -1;
+    else
+      pos += written;
+  }
+  _gid_events.size = 0;
+  _gid_start_timer(&_gid_events.flush_timer);
+}
+
+/* Adds a character to the buffered events, as it is.
+ * @param c - The character to add. */
+void _gid_put_event_char(char c)
+{
+  if(_gid_events.size == GID_EVENT_BUFFER_SIZE)
+    _gid_flush_events();
+  _gid_events.buffer[_gid_events.size++] = c;
+}
+
+/* Adds a string to the buffered events, as it is.
+ * @param str - The string to add. */
+void _gid_put_event_raw(const char* str)
+{
+  for(const char* c = str; *c != '\0'; c++)
+    _gid_put_event_char(*c);
+}
+
+/* Adds a string field to the event that is being buffered, escaping the
+ * value as a JSON string.
+ * @param name - The name of the field.
+ * @param value - The value of the field. */
+void _gid_put_event_string(const char* name, const char* value)
+{
+  char escaped[8];
+  _gid_put_event_raw(",\"");
+  _gid_put_event_raw(name);
+  _gid_put_event_raw("\":\"");
+  for(const char* c = value; *c != '\0'; c++)
+  {
+    switch(*c)
+    {
+      case '"':
+        _gid_put_event_raw("\\\"");
+        break;
+      case '\\':
+        _gid_put_event_raw("\\\\");
+        break;
+      case '\n':
+        _gid_put_event_raw("\\n");
+        break;
+      case '\r':
+        _gid_put_event_raw("\\r");
+        break;
+      case '\t':
+        _gid_put_event_raw("\\t");
+        break;
+      default:
+        if((unsigned char)*c < 0x20)
+        {
+          snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)*c);
+          _gid_put_event_raw(escaped);
+        }
+        else
+          _gid_put_event_char(*c);
+        break;
+    }
+  }
+  _gid_put_event_raw("\"");
+}
+
+/* Adds an unsigned integer field to the event that is being buffered.
+ * @param name - The name of the field.
+ * @param value - The value of the field. */
+void _gid_put_event_uint(const char* name, uint64_t value)
+{
+  char number[32];
+  snprintf(number, sizeof(number), "%"PRIu64, value);
+  _gid_put_event_raw(",\"");
+  _gid_put_event_raw(name);
+  _gid_put_event_raw("\":");
+  _gid_put_event_raw(number);
+}
+
+/* Starts buffering an event, whose fields are then added with
+ * _gid_put_event_string and _gid_put_event_uint. The name of the suite that
+ * is running is added, if there is one.
+ * @param type - The type of the event, such as "test_start". */
+void _gid_begin_event(const char* type)
+{
+  _gid_put_event_raw("{\"event\":\"");
+  _gid_put_event_raw(type);
+  _gid_put_event_raw("\"");
+  if(_gid_events.suite != NULL)
+    _gid_put_event_string("suite", _gid_events.suite->name);
+}
+
+/* Finishes buffering an event, and writes the buffer if it hasn't been
+ * written for a second. */
+void _gid_end_event()
+{
+  _gid_put_event_raw("}\n");
+  if(_gid_read_timer(&_gid_events.flush_timer) >= 1000000000)
+    _gid_flush_events();
+}
+
+/* Gets the name of a GIDRunResult, as used in events.
+ * @param result - The GIDRunResult.
+ * @returns - The name of the result. */
+const char* _gid_get_run_result_name(GIDRunResult result)
+{
+  switch(result)
+  {
+    case GID_RUN_RESULT_FAILED:
+      return "failed";
+    case GID_RUN_RESULT_PASSED:
+      return "passed";
+    default:
+      return "skipped";
+  }
+}
+
+/* Opens the stream of JSON events, if the events_path or events_fd of
+ * GIDOptions is set. This must be done after the tests are registered.
+ * @returns - Zero if the file of the stream couldn't be opened, otherwise
+ *          non-zero. */
+int _gid_open_events()
+{
+  _gid_events.is_open = 0;
+  _gid_events.file = NULL;
+  _gid_events.suite = NULL;
+  _gid_events.size = 0;
+  if(_gid_options.events_path != NULL)
+  {
+    _gid_events.file = fopen(_gid_options.events_path, "wb");
+    if(_gid_events.file == NULL)
+      return 0;
+#ifdef _WIN32
+    _gid_events.fd = _fileno(_gid_events.file);
+#else
+    _gid_events.fd = fileno(_gid_events.file);
+#endif
+  }
+  else if(_gid_options.events_fd >= 0)
+  {
+    _gid_events.fd = _gid_options.events_fd;
+  }
+  else
+  {
+    return 1;
+  }
+
+  size_t maxParamCount = _gid_get_max_param_count();
+  _gid_events.positions = malloc(sizeof(size_t) * (maxParamCount + 1));
+  _gid_events.values = malloc(sizeof(GIDParamValue) * (maxParamCount + 1));
+  _gid_events.is_open = 1;
+  _gid_start_timer(&_gid_events.flush_timer);
+  return 1;
+}
+
+/* Writes the buffered events, and closes the stream of JSON events if it is
+ * open. A file descriptor that was given in the options is left open. */
+void _gid_close_events()
+{
+  if(!_gid_events.is_open)
+    return;
+  _gid_flush_events();
+  if(_gid_events.file != NULL)
+    fclose(_gid_events.file);
+  free(_gid_events.positions);
+  free(_gid_events.values);
+  _gid_events.is_open = 0;
+}
+
+/* Writes the event that a test suite is about to run, if the stream of
+ * events is open.
+ * @param suite - Pointer to the GIDTestSuite. */
+void _gid_write_event_suite_start(const GIDTestSuite* suite)
+{
+  if(!_gid_events.is_open)
+    return;
+  _gid_events.suite = suite;
+  _gid_begin_event("suite_start");
+  _gid_end_event();
+}
+
+/* Writes the event that a test suite has finished, if the stream of events
+ * is open. */
+void _gid_write_event_suite_end()
+{
+  if(!_gid_events.is_open)
+    return;
+  _gid_begin_event("suite_end");
+  _gid_end_event();
+  _gid_events.suite = NULL;
+  _gid_flush_events();
+}
+
+/* Writes the event that a test is about to run, if the stream of events is
+ * open. When the tests run in parallel, the results of its configurations
+ * may already have been written.
+ * @param test - Pointer to the GIDTest. */
+void _gid_write_event_test_start(const GIDTest* test)
+{
+  if(!_gid_events.is_open)
+    return;
+  _gid_begin_event("test_start");
+  _gid_put_event_string("test", test->name);
+  _gid_put_event_uint("configurations", test->total_config_count);
+  _gid_end_event();
+}
+
+/* Writes the event that a test has finished, if the stream of events is
+ * open, and writes the buffered events.
+ * @param test - Pointer to the GIDTest, whose status is final. */
+void _gid_write_event_test_end(const GIDTest* test)
+{
+  if(!_gid_events.is_open)
+    return;
+  _gid_begin_event("test_end");
+  _gid_put_event_string("test", test->name);
+  _gid_put_event_string("status",
+    test->status == GID_TEST_PASSED ? "passed" : "failed");
+  _gid_put_event_uint("configurations", test->total_config_count);
+  _gid_put_event_uint("passed", test->pass_config_count);
+  _gid_put_event_uint("skipped", test->skip_config_count);
+  _gid_put_event_uint("runtime_ns", test->total_runtime);
+  _gid_end_event();
+  _gid_flush_events();
+}
+
+/* Writes the event of a failure, if the stream of events is open.
+ * @param test - Pointer to the GIDTest.
+ * @param failure - Pointer to the GIDTestFailure. */
+void _gid_write_event_failure(
+  const GIDTest* test,
+  const GIDTestFailure* failure)
+{
+  const char* stepNames[3] = { "setup", "run", "teardown" };
+  if(!_gid_events.is_open)
+    return;
+  _gid_begin_event("failure");
+  _gid_put_event_string("test", test->name);
+  _gid_put_event_uint("index", failure->configuration_index);
+  _gid_put_event_string("configuration", failure->configuration);
+  _gid_put_event_string("step", stepNames[failure->step]);
+  _gid_put_event_string("file", failure->source_file);
+  _gid_put_event_uint("line", failure->line);
+  _gid_put_event_string("message", failure->message);
+  _gid_end_event();
+}
+
+/* Writes the events of the failures of a run of a configuration and its
+ * result, if the stream of events is open.
+ * @param test - Pointer to the GIDTest.
+ * @param index - The zero-based index of the configuration.
+ * @param result - The GIDRunResult of the run.
+ * @param runtime - The runtime of the run, in nanoseconds.
+ * @param failures - Pointer to the first GIDTestFailure of the run, which
+ *        is followed only by the other failures of the run, or NULL. */
+void _gid_write_event_run(
+  const GIDTest* test,
+  uint64_t index,
+  GIDRunResult result,
+  uint64_t runtime,
+  const GIDTestFailure* failures)
+{
+  if(!_gid_events.is_open)
+    return;
+  for(const GIDTestFailure* f = failures; f != NULL; f = f->next)
+    _gid_write_event_failure(test, f);
+
+  char config[GID_MAX_CONFIGURATION_STRING_LENGTH];
+  _gid_get_config_string(
+    test,
+    index,
+    _gid_events.positions,
+    _gid_events.values,
+    config,
+    GID_MAX_CONFIGURATION_STRING_LENGTH);
+  _gid_begin_event("config");
+  _gid_put_event_string("test", test->name);
+  _gid_put_event_uint("index", index);
+  _gid_put_event_string("configuration", config);
+  _gid_put_event_string("status", _gid_get_run_result_name(result));
+  _gid_put_event_uint("runtime_ns", runtime);
+  _gid_end_event();
+}
+
+/* The magic number at the start of a binary results file (see
+ * GIDResultsHeader). */
+#define GID_RESULTS_MAGIC "GIDRSLT"
+
+/* The version of the layout of a binary results file. */
+#define GID_RESULTS_VERSION (1)
+
+/* The header at the start of a binary results file (see the results_path of
+ * GIDOptions). The file is laid out as:
+ *   GIDResultsHeader
+ *   GIDResultsRecord[record_count], in the order that the runs finished
+ *   GIDResultsTest[test_count], in the order that the tests were registered
+ *   The string table, which is 'strings_size' chars of NUL-terminated strings
+ * All integers are in the byte order of the machine that ran the tests. The
+ * records are written as the runs finish, and the rest of the header, the
+ * tests and the strings are only written once all tests have run. If the run
+ * didn't finish, 'strings_offset' is zero, and the number of records can
+ * only be found from the size of the file. */
+typedef struct GIDResultsHeader
+{
+  /* GID_RESULTS_MAGIC, including its NUL terminator. */
+  char magic[8];
+
+  /* GID_RESULTS_VERSION. */
+  uint32_t version;
+
+  /* The size of a GIDResultsRecord, in bytes. */
+  uint32_t record_size;
+
+  /* The number of GIDResultsRecords. */
+  uint64_t record_count;
+
+  /* The number of GIDResultsTests. */
+  uint64_t test_count;
+
+  /* The offset of the first GIDResultsTest in the file. */
+  uint64_t tests_offset;
+
+  /* The offset of the string table in the file, or zero if the run didn't
+   * finish. */
+  uint64_t strings_offset;
+
+  /* The size of the string table, in chars. */
+  uint64_t strings_size;
+
+  /* The number of test suites. */
+  uint32_t suite_count;
+
+  /* Reserved, always zero. */
+  uint32_t reserved;
+} GIDResultsHeader;
+
+/* The result of a run of a configuration in a binary results file. */
+typedef struct GIDResultsRecord
+{
+  /* The zero-based index of the configuration. */
+  uint64_t configuration_index;
+
+  /* The runtime of the run, in nanoseconds. */
+  uint64_t runtime;
+
+  /* The offset in the string table of the failures of the run, or
+   * UINT64_MAX if it didn't fail. This is one string, with the
+   * configuration on the first line, followed by a line for each failure. */
+  uint64_t failure;
+
+  /* The zero-based index of the test suite. */
+  uint32_t suite_index;
+
+  /* The zero-based index of the GIDResultsTest (see the 'index' of
+   * GIDTest). */
+  uint32_t test_index;
+
+  /* The GIDRunResult of the run. */
+  uint32_t status;
+
+  /* Reserved, always zero. */
+  uint32_t reserved;
+} GIDResultsRecord;
+
+/* A test in a binary results file. Its strings are stored once, no matter
+ * how many configurations it has. */
+typedef struct GIDResultsTest
+{
+  /* The offset in the string table of the name of the test suite. */
+  uint64_t suite_name;
+
+  /* The offset in the string table of the name of the test. */
+  uint64_t name;
+
+  /* The offset in the string table of the source file of the test. */
+  uint64_t source_file;
+
+  /* The zero-based index of the test suite. */
+  uint32_t suite_index;
+
+  /* Reserved, always zero. */
+  uint32_t reserved;
+} GIDResultsTest;
+
+/* Contains the state of the binary results file (see GIDResultsHeader). The
+ * records are appended to the file as the runs finish, while the strings are
+ * appended to a temporary file, which becomes the string table once all
+ * tests have run. */
+typedef struct GIDResultsFile
+{
+  /* The results file, or NULL if no results are written. */
+  FILE* file;
+
+  /* The temporary file of the string table. */
+  FILE* strings;
+
+  /* The number of chars that have been written to 'strings'. */
+  uint64_t strings_size;
+
+  /* The tests, whose strings were written when the file was opened. */
+  GIDResultsTest* tests;
+
+  /* The number of tests. */
+  uint64_t test_count;
+
+  /* The zero-based index of the test suite that is running, or the number
+   * of test suites that have run. */
+  uint32_t suite_index;
+
+  /* The number of records that have been written. */
+  uint64_t record_count;
+} GIDResultsFile;
+
+/* The binary results file. When the tests run in parallel, this is protected
+ * by the lock of the GIDPool. */
+GIDResultsFile _gid_results;
+
+/* Adds a string to the string table of the binary results file.
+ * @param str - The string to add, which may be NULL for an empty string.
+ * @returns - The offset of the string in the string table. */
+uint64_t _gid_add_results_string(const char* str)
+{
+  uint64_t offset = _gid_results.strings_size;
+  if(str == NULL)
+    str = "";
+  size_t len = strlen(str) + 1;
+  fwrite(str, 1, len, _gid_results.strings);
+  _gid_results.strings_size += len;
+  return offset;
+}
+
+/* Opens the binary results file at the results_path of GIDOptions, if it is
+ * set, and writes the strings of each test. This must be done after the
+ * tests are registered.
+ * @returns - Zero if the file couldn't be opened, otherwise non-zero. */
+int _gid_open_results()
+{
+  memset(&_gid_results, 0, sizeof(GIDResultsFile));
+  if(_gid_options.results_path == NULL)
+    return 1;
+  _gid_results.file = fopen(_gid_options.results_path, "wb");
+  if(_gid_results.file == NULL)
+    return 0;
+  _gid_results.strings = tmpfile();
+  if(_gid_results.strings == NULL)
+  {
+    fclose(_gid_results.file);
+    _gid_results.file = NULL;
+    return 0;
+  }
+
+  //Until the run finishes, the header only identifies the file
+  GIDResultsHeader header;
+  memset(&header, 0, sizeof(GIDResultsHeader));
+  memcpy(header.magic, GID_RESULTS_MAGIC, sizeof(GID_RESULTS_MAGIC));
+  header.version = GID_RESULTS_VERSION;
+  header.record_size = sizeof(GIDResultsRecord);
+  fwrite(&header, sizeof(GIDResultsHeader), 1, _gid_results.file);
+
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+      _gid_results.test_count++;
+  }
+  _gid_results.tests = malloc(
+    sizeof(GIDResultsTest) * (_gid_results.test_count + 1));
+  uint32_t suiteIndex = 0;
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    uint64_t suiteName = _gid_add_results_string(suite->name);
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      GIDResultsTest* dst = &_gid_results.tests[test->index];
+      dst->suite_name = suiteName;
+      dst->name = _gid_add_results_string(test->name);
+      dst->source_file = _gid_add_results_string(test->source_file);
+      dst->suite_index = suiteIndex;
+      dst->reserved = 0;
+    }
+    suiteIndex++;
+  }
+  return 1;
+}
+
+/* Writes the tests and the string table to the binary results file, if one
+ * is open, completes its header, and closes it.
+ * @returns - Zero if the file couldn't be written, otherwise non-zero. */
+int _gid_close_results()
+{
+  if(_gid_results.file == NULL)
+    return 1;
+
+  GIDResultsHeader header;
+  memset(&header, 0, sizeof(GIDResultsHeader));
+  memcpy(header.magic, GID_RESULTS_MAGIC, sizeof(GID_RESULTS_MAGIC));
+  header.version = GID_RESULTS_VERSION;
+  header.record_size = sizeof(GIDResultsRecord);
+  header.record_count = _gid_results.record_count;
+  header.test_count = _gid_results.test_count;
+  header.tests_offset = sizeof(GIDResultsHeader)
+    + _gid_results.record_count * sizeof(GIDResultsRecord);
+  header.strings_offset = header.tests_offset
+    + _gid_results.test_count * sizeof(GIDResultsTest);
+  header.strings_size = _gid_results.strings_size;
+  header.suite_count = _gid_results.suite_index;
+
+  fwrite(
+    _gid_results.tests,
+    sizeof(GIDResultsTest),
+    (size_t)_gid_results.test_count,
+    _gid_results.file);
+  char buffer[4096];
+  size_t size;
+  rewind(_gid_results.strings);
+  while((size = fread(buffer, 1, sizeof(buffer), _gid_results.strings)) > 0)
+    fwrite(buffer, 1, size, _gid_results.file);
+  int ret = !ferror(_gid_results.strings);
+  fclose(_gid_results.strings);
+
+  //The header is written last, so it is only complete if everything else is
+  if(fseek(_gid_results.file, 0, SEEK_SET) != 0)
+    ret = 0;
+  fwrite(&header, sizeof(GIDResultsHeader), 1, _gid_results.file);
+  if(ferror(_gid_results.file))
+    ret = 0;
+  if(fclose(_gid_results.file) != 0)
+    ret = 0;
+  free(_gid_results.tests);
+  memset(&_gid_results, 0, sizeof(GIDResultsFile));
+  return ret;
+}
+
+/* Writes the text of failures to the string table of the binary results
+ * file, which must be open.
+ * @param first - Pointer to the first GIDTestFailure.
+ * @param end - Pointer to the GIDTestFailure just past the last one, or NULL
+ *        for the end of the list.
+ * @returns - The offset of the text in the string table. */
+uint64_t _gid_write_results_failures(
+  const GIDTestFailure* first,
+  const GIDTestFailure* end)
+{
+  const char* stepNames[3] = { "setup", "run", "teardown" };
+  FILE* strings = _gid_results.strings;
+  uint64_t offset = _gid_results.strings_size;
+  int len = fprintf(strings, "%s\n", first->configuration);
+  if(len > 0)
+    _gid_results.strings_size += len;
+  for(const GIDTestFailure* f = first; f != end; f = f->next)
+  {
+    len = fprintf(strings, "%s:%i (%s): %s\n",
+      f->source_file,
+      f->line,
+      stepNames[f->step],
+      f->message);
+    if(len > 0)
+      _gid_results.strings_size += len;
+  }
+  fputc('\0', strings);
+  _gid_results.strings_size++;
+  return offset;
+}
+
+/* Writes a record to the binary results file, if one is open, along with
+ * the text of its failures. A run that ended without a result (such as by
+ * skip) is recorded as skipped.
+ * @param test - Pointer to the GIDTest.
+ * @param index - The zero-based index of the configuration.
+ * @param result - The GIDRunResult of the run.
+ * @param runtime - The runtime of the run, in nanoseconds.
+ * @param first - Pointer to the first GIDTestFailure of the run, or NULL.
+ * @param end - Pointer to the GIDTestFailure just past the last one, or NULL
+ *        for the end of the list.
+ * @returns - The index of the record, or UINT64_MAX if no file is open. */
+uint64_t _gid_write_results_record(
+  const GIDTest* test,
+  uint64_t index,
+  GIDRunResult result,
+  uint64_t runtime,
+  const GIDTestFailure* first,
+  const GIDTestFailure* end)
+{
+  if(_gid_results.file == NULL)
+    return UINT64_MAX;
+
+  GIDResultsRecord record;
+  record.configuration_index = index;
+  record.runtime = runtime;
+  record.failure = UINT64_MAX;
+  record.suite_index = _gid_results.suite_index;
+  record.test_index = test->index;
+  record.status = result == GID_RUN_RESULT_PENDING
+    ? GID_RUN_RESULT_SKIPPED
+    : (uint32_t)result;
+  record.reserved = 0;
+  if(first != end)
+    record.failure = _gid_write_results_failures(first, end);
+  fwrite(&record, sizeof(GIDResultsRecord), 1, _gid_results.file);
+  return _gid_results.record_count++;
+}
+
+/* Changes a record that was already written to the binary results file into
+ * a failure, such as when a Benchmark that passed turns out to be slower
+ * than its baseline.
+ * @param recordIndex - The index of the record, or UINT64_MAX to do nothing.
+ * @param first - Pointer to the first GIDTestFailure of the run.
+ * @param end - Pointer to the GIDTestFailure just past the last one, or NULL
+ *        for the end of the list. */
+void _gid_fail_results_record(
+  uint64_t recordIndex,
+  const GIDTestFailure* first,
+  const GIDTestFailure* end)
+{
+  if(_gid_results.file == NULL || recordIndex == UINT64_MAX)
+    return;
+
+  uint64_t failure = _gid_write_results_failures(first, end);
+  uint32_t status = GID_RUN_RESULT_FAILED;
+  long pos = (long)(sizeof(GIDResultsHeader)
+    + recordIndex * sizeof(GIDResultsRecord));
+  FILE* file = _gid_results.file;
+  fseek(file, pos + (long)offsetof(GIDResultsRecord, failure), SEEK_SET);
+  fwrite(&failure, sizeof(failure), 1, file);
+  fseek(file, pos + (long)offsetof(GIDResultsRecord, status), SEEK_SET);
+  fwrite(&status, sizeof(status), 1, file);
+  fseek(file, 0, SEEK_END);
+}
+
+/* Ends a test suite in the binary results file, so the records that follow
+ * belong to the next suite. */
+void _gid_end_results_suite()
+{
+  if(_gid_results.file != NULL)
+    _gid_results.suite_index++;
+}
+
+/* Writes the result of a run of a configuration to the JUnit XML report, the
+ * stream of events and the binary results file, as each of them needs. When the tests run in
+ * parallel, the caller must hold the lock of the GIDPool.
+ * @param test - Pointer to the GIDTest.
+ * @param index - The zero-based index of the configuration.
+ * @param result - The GIDRunResult of the run.
+ * @param runtime - The runtime of the run, in nanoseconds.
+ * @param failures - Pointer to the first GIDTestFailure of the run, which
+ *        is followed only by the other failures of the run, or NULL.
+ * @returns - The index of the record of the run in the binary results file,
+ *          or UINT64_MAX if it has none. */
+uint64_t _gid_report_run(
+  const GIDTest* test,
+  uint64_t index,
+  GIDRunResult result,
+  uint64_t runtime,
+  const GIDTestFailure* failures)
+{
+  _gid_write_junit_run(test, index, result, runtime, failures);
+  _gid_write_event_run(test, index, result, runtime, failures);
+  return _gid_write_results_record(
+    test,
+    index,
+    result,
+    runtime,
+    failures,
+    NULL);
+}
+
+/* Checks whether the result of each run is reported as it finishes (see
+ * _gid_report_run), rather than only with the rest of its test.
+ * @returns - Non-zero if the runs are reported. */
+int _gid_is_run_reported()
+{
+  return _gid_junit.is_per_config
+    || _gid_events.is_open
+    || _gid_results.file != NULL;
+}
+
+/* Prints which values of each parameter the failures of a GIDFailureGroup
+ * had, such as 'i=3..17, word="Alpha"|"Bravo", j: all 4 values'.
+ * @param test - Pointer to the GIDTest.
+ * @param group - Pointer to the GIDFailureGroup, whose 'params' isn't
+ *        NULL. */
+void _gid_print_param_spread(const GIDTest* test, const GIDFailureGroup* group)
+{
+  int first = 1;
+  for(GIDParamBase* param = test->first_param;
+    param != NULL;
+    param = param->next)
+  {
+    size_t count = _gid_param_value_count(param);
+    const GIDParamSpread* spread = &group->params[param->slot];
+    if(count == 0 || spread->min_position > spread->max_position)
+      continue;
+    printf("%s%s", first ? "" : ", ", param->name);
+    first = 0;
+
+    char value[GID_MAX_CONFIGURATION_STRING_LENGTH];
+    int seen = 0;
+    for(uint64_t mask = spread->position_mask; mask != 0; mask &= mask - 1)
+      seen++;
+    if(count > 1 && count <= 64 && (size_t)seen == count)
+    {
+      printf(": all %i values", seen);
+    }
+    else if(count <= 64 && seen <= 4)
+    {
+      printf("=");
+      for(size_t pos = spread->min_position; pos <= spread->max_position; pos++)
+      {
+        if((spread->position_mask & ((uint64_t)1 << pos)) == 0)
+          continue;
+        _gid_param_get_value_string(param, pos, value, sizeof(value));
+        printf("%s%s", pos == spread->min_position ? "" : "|", value);
+      }
+    }
+    else if(count <= 64)
+    {
+      printf(": %i of %i values", seen, (int)count);
+    }
+    else
+    {
+      _gid_param_get_value_string(
+        param,
+        spread->min_position,
+        value,
+        sizeof(value));
+      printf("=%s", value);
+      if(spread->max_position > spread->min_position)
+      {
+        _gid_param_get_value_string(
+          param,
+          spread->max_position,
+          value,
+          sizeof(value));
+        printf("..%s", value);
+      }
+    }
+  }
+  printf("\n");
+}
+
+/* Prints a group of failures of a test with the same cause, for the summary.
+ * A group of one failure is printed as that failure. Otherwise, the number
+ * of failures, the first examples and the values of the parameters are
+ * printed.
+ * @param suite - Pointer to the GIDTestSuite that contains the test.
+ * @param test - Pointer to the GIDTest.
+ * @param group - Pointer to the GIDFailureGroup. */
+void _gid_print_failure_group(
+  const GIDTestSuite* suite,
+  const GIDTest* test,
+  const GIDFailureGroup* group)
+{
+  const GIDTestFailure* example = group->examples[0];
+  const char* step;
+  switch(group->step)
+  {
+    case GID_STEP_SETUP:
+      step = "\t[Setup]";
+      break;
+    case GID_STEP_TEARDOWN:
+      step = "\t[Teardown]";
+      break;
+    default:
+      step = "";
+      break;
+  }
+
+  if(group->count == 1)
+  {
+    printf("%s > %s(%s) Failed\n",
+      suite->name,
+      test->name,
+      example->configuration);
+  }
+  else
+  {
+    printf("%s > %s Failed %"PRIu64" configurations\n",
+      suite->name,
+      test->name,
+      group->count);
+  }
+  if(_gid_progress.is_terminal)
+    printf("  Message:\t\033[31m%s\033[0m\n", example->message);
+  else
+    printf("  Message:\t%s\n", example->message);
+  printf("  Location:\t%s @%i%s\n",
+    group->source_file,
+    group->line,
+    step);
+  if(group->count > 1)
+  {
+    for(size_t i = 0; i < group->example_count; i++)
+    {
+      printf("%s(%s)\n",
+        i == 0 ? "  Examples:\t" : "\t\t",
+        group->examples[i]->configuration);
+    }
+    if(group->count > group->example_count)
+    {
+      printf("\t\t...and %"PRIu64" more\n",
+        group->count - group->example_count);
+    }
+    if(group->params != NULL)
+    {
+      printf("  Values:\t");
+      _gid_print_param_spread(test, group);
+    }
+  }
+  if(test->shuffle_count > 0)
+  {
+    printf("  Replay:\tGID_SEED=%"PRIu64" (configuration index",
+      _gid_options.seed);
+    for(size_t i = 0; i < group->example_count; i++)
+    {
+      printf("%s %"PRIu64,
+        i == 0 ? (group->example_count > 1 ? "es" : "") : ",",
+        group->examples[i]->configuration_index);
+    }
+    printf(")\n");
+  }
+  printf("\n");
+}
+
+/* Prints a summary of the test results.
+ * @returns - The exit code, where zero means all tests passed, and non-zero
+ *          means that at least one test failed. */
+int _gid_summary()
+{
+  int32_t totalSuites = 0;
+  int32_t passSuites = 0;
+  int32_t failSuites = 0;
+  int32_t totalTests = 0;
+  int32_t passTests = 0;
+  int32_t failTests = 0;
+  uint64_t totalTestConfigs = 0;
+  uint64_t passTestConfigs = 0;
+  uint64_t skipTestConfigs = 0;
+
+  GIDTestSuite* suite = _gid_first_suite;
+  while(suite != NULL)
+  {
+    totalSuites++;
+    int32_t cur_totalTests = 0,
+      cur_passTests = 0,
+      cur_failTests = 0;
+    uint64_t cur_totalConfigs = 0,
+      cur_passConfigs = 0,
+      cur_skipConfigs = 0;
+
+    _gid_get_suite_summary(
+      suite,
+      &cur_totalTests,
+      &cur_passTests,
+      &cur_failTests,
+      &cur_totalConfigs,
+      &cur_passConfigs,
+      &cur_skipConfigs);
+
+    if(cur_totalTests == 0 && suite->first_test != NULL)
+    {
+      totalSuites--;
+      suite = suite->next;
+      continue;//No tests in this shard
+    }
+
+    totalTests += cur_totalTests;
+    passTests += cur_passTests;
+    failTests += cur_failTests;
+    totalTestConfigs += cur_totalConfigs;
+    passTestConfigs += cur_passConfigs;
+    skipTestConfigs += cur_skipConfigs;
+
+    if(cur_failTests > 0)
+      failSuites++;
+    else
+      passSuites++;
+
+    suite = suite->next;
+  }
+
+  printf("\n========SUMMARY========\n");
+  printf("%i suites tested, %i passed without failures, "
+    "and %i had at least one test failure.\n",
+    totalSuites,
+    passSuites,
+    failSuites);
+
+  printf("%i tests total, %i tests passed, and %i failed.\n",
+    totalTests,
+    passTests,
+    failTests);
+  printf("%"PRIu64" total test configurations, %"PRIu64" passed, "
+    "%"PRIu64" failed, and %"PRIu64" skipped.\n",
+    totalTestConfigs,
+    passTestConfigs,
+    totalTestConfigs-(passTestConfigs+skipTestConfigs),
+    skipTestConfigs);
+  if(_gid_events.is_open)
+  {
+    _gid_begin_event("summary");
+    _gid_put_event_uint("suites", totalSuites);
+    _gid_put_event_uint("passed_suites", passSuites);
+    _gid_put_event_uint("tests", totalTests);
+    _gid_put_event_uint("passed_tests", passTests);
+    _gid_put_event_uint("configurations", totalTestConfigs);
+    _gid_put_event_uint("passed", passTestConfigs);
+    _gid_put_event_uint("skipped", skipTestConfigs);
+    _gid_end_event();
+  }
+
+  _gid_print_benchmark_results();
+  _gid_print_perf_counters();
+  _gid_print_heap_allocations();
+
+  if(failSuites > 0 || failTests > 0)
+  {
+    _gid_print_heading("30;41", "Failures");
+    suite = _gid_first_suite;
+    while(suite != NULL)
+    {
+      int32_t cur_totalTests = 0,
+        cur_passTests = 0,
+        cur_failTests = 0;
+      uint64_t cur_totalConfigs = 0,
+        cur_passConfigs = 0,
+        cur_skipConfigs = 0;
+
+      _gid_get_suite_summary(
+        suite,
+        &cur_totalTests,
+        &cur_passTests,
+        &cur_failTests,
+        &cur_totalConfigs,
+        &cur_passConfigs,
+        &cur_skipConfigs);
+
+      if(cur_failTests > 0
+        || (cur_totalConfigs != cur_passConfigs + cur_skipConfigs))
+      {
+        GIDTest* test = suite->first_test;
+        while(test != NULL)
+        {
+          for(GIDFailureGroup* group = test->first_failure_group;
+            group != NULL;
+            group = group->next)
+          {
+            printf("------------------------------------------------------\n");
+            _gid_print_failure_group(suite, test, group);
+          }
+          if(test->ungrouped_failure_count > 0)
+          {
+            printf("------------------------------------------------------\n");
+            printf("%s > %s failed %"PRIu64" more configurations, whose "
+              "causes didn't fit in the first %i groups.\n\n",
+              suite->name,
+              test->name,
+              test->ungrouped_failure_count,
+              GID_MAX_FAILURE_GROUPS);
+          }
+
+          test = test->next;
+        }
+      }
+      suite = suite->next;
+    }
+  }
+
+  return failSuites == 0 ? 0/*No-error*/ : -1/*Fail*/;
+}
+
+/* Frees all memory allocated for GID testing. */
+void _gid_free()
+{
+  GIDTestSuite* suite = _gid_first_suite;
+  while(suite != NULL)
+  {
+    _gid_free_suite(suite);
+    suite = suite->next;
+  }
+  _gid_first_suite = NULL;
+  _gid_last_suite = NULL;
+  _gid_free_arena(&_gid_registration_arena);
+  _gid_free_baselines();
+  _gid_free_interned_strings();
+}
+
+/* Registers a test suite.
+ * @param suite - Pointer to the GIDTestSuite to register. */
+void _gid_add_test_suite(GIDTestSuite* suite)
+{
+  GIDTestSuite* prev = _gid_last_suite;
+  _gid_last_suite = suite;
+
+  if(_gid_first_suite == NULL)
+    _gid_first_suite = suite;
+  if(prev != NULL)
+    prev->next = suite;
+}
+
+/* Adds a test to a suite.
+ * @param dst - Pointer to the destination GIDTestSuite.
+ * @param test - Pointer to the GIDTest to add. */
+void _gid_add_test(GIDTestSuite* dst, GIDTest* test)
+{
+  GIDTest* prev = dst->last_test;
+  dst->last_test = test;
+
+  if(dst->first_test == NULL)
+    dst->first_test = test;
+  if(prev != NULL)
+    prev->next = test;
+}
+
+/* Prints the current status of a test on the lowest line. On a terminal,
+ * this will erase the lowest line then overwrite it, and the status is
+ * colored. Nothing is flushed, so see _gid_report_progress and
+ * _gid_post_test for that. */
+void _gid_print_test_status(const GIDTest* test)
+{
+  const int color = _gid_progress.is_terminal;
+  const char* statusStr = "?";
+  switch(test->status)
+  {
+    case GID_TEST_PENDING:
+      statusStr = color ? "\033[37;40m IDLE \033[0m" : " IDLE ";
+      break;
+
+    case GID_TEST_RUNNING:
+      statusStr = color ? "\033[30;43m RUN \033[0m" : " RUN ";
+      break;
+
+    case GID_TEST_FAILED:
+      statusStr = color ? "\033[30;41m FAIL \033[0m" : " FAIL ";
+      break;
+
+    case GID_TEST_PASSED:
+      statusStr = color ? "\033[30;42m PASS \033[0m" : " PASS ";
+      break;
+  }
+
+  if(_gid_progress.is_terminal)
+    _gid_clear_console_line();
+  printf("%s\t%s\t%"PRIu64"/%"PRIu64" configurations passed",
+    statusStr,
+    test->name,
+    test->pass_config_count,
+    test->total_config_count);
+  if(test->skip_config_count > 0)
+    printf("\t(%"PRIu64" skipped)", test->skip_config_count);
+  if(test->is_complete && test->run_config_count > 0)
+  {
+    char total[32];
+    _gid_format_duration((double)test->total_runtime, total, sizeof(total));
+    if(test->total_config_count > 1)
+    {
+      char avg[32];
+      _gid_format_duration(
+        (double)test->total_runtime / test->run_config_count,
+        avg,
+        sizeof(avg));
+      printf("\t[%s total, avg %s per configuration]", total, avg);
+    }
+    else
+    {
+      printf("\t[%s]", total);
+    }
+
+    uint64_t allocCount = _gid_get_heap_alloc_count(&test->heap);
+    if(allocCount > 0)
+    {
+      uint64_t allocBytes = test->heap.steps[GID_STEP_SETUP].alloc_bytes
+        + test->heap.steps[GID_STEP_RUN].alloc_bytes
+        + test->heap.steps[GID_STEP_TEARDOWN].alloc_bytes;
+      char count[32];
+      char bytes[32];
+      char peak[32];
+      _gid_format_metric(
+        (double)allocCount / test->run_config_count,
+        "",
+        count,
+        sizeof(count));
+      _gid_format_metric(
+        (double)allocBytes / test->run_config_count,
+        "B",
+        bytes,
+        sizeof(bytes));
+      _gid_format_metric(
+        (double)test->heap.max_peak_bytes,
+        "B",
+        peak,
+        sizeof(peak));
+      printf("\t[avg %s allocs (%s) per configuration, peak %s]",
+        count,
+        bytes,
+        peak);
+    }
+  }
+}
+
+/* Updates the progress line with the status of a test, unless it was updated
+ * less than the interval ago (see GIDProgress), or there is no progress line.
+ * This is called as each configuration starts and finishes, so it does no
+ * I/O at all most of the time.
+ * @param test - Pointer to the GIDTest that is running. */
+void _gid_report_progress(const GIDTest* test)
+{
+  if(_gid_progress.interval == 0)
+    return;
+  if(_gid_progress.is_showing
+    && _gid_read_timer(&_gid_progress.timer) < _gid_progress.interval)
+    return;
+  _gid_start_timer(&_gid_progress.timer);
+  _gid_print_test_status(test);
+  fflush(stdout);
+  _gid_progress.is_showing = 1;
+}
+
+/* Prepares to run a test (before any specific configuration is executed).
+ * This will update the status of the test to 'running' (unless a
+ * configuration has already failed, which can happen when configurations
+ * run in parallel), will write its event, and will print the status to
+ * stdout.
+ * @param test - Pointer to the GIDTest that is being prepared. */
+void _gid_pre_test(GIDTest* test)
+{
+  if(test->status == GID_TEST_PENDING)
+    test->status = GID_TEST_RUNNING;
+  _gid_write_event_test_start(test);
+  _gid_report_progress(test);
+}
+
+/* Finalizes the result of a test after all configurations have been run.
+ * This will determine whether the test passed or failed (based on whether
+ * any configuration resulted in failure), compare the Benchmark measurements
+ * with their baselines, order the groups of failures, will write
+ * the test to the JUnit XML report and the stream of events, and will print
+ * the status to stdout.
+ * @param suite - Pointer to the GIDTestSuite that contains the test.
+ * @param test - Pointer to the GIDTest that has finished. */
+void _gid_post_test(const GIDTestSuite* suite, GIDTest* test)
+{
+  //Configurations may run in any order, so sort the results for the summary
+  test->first_benchmark = _gid_sort_benchmark_results(test->first_benchmark);
+  test->last_benchmark = test->first_benchmark;
+  while(test->last_benchmark != NULL && test->last_benchmark->next != NULL)
+    test->last_benchmark = test->last_benchmark->next;
+  GIDArena regressionArena;
+  memset(&regressionArena, 0, sizeof(GIDArena));
+  GIDTestFailure* regressions =
+    _gid_check_baseline(suite, test, &regressionArena);
+  //The runs were reported as they finished, so report the regressions too.
+  //The regressions are in the same order as the measurements.
+  GIDBenchmarkResult* measured = test->first_benchmark;
+  for(GIDTestFailure* regression = regressions;
+    regression != NULL;
+    regression = regression->next)
+  {
+    while(measured->configuration_index != regression->configuration_index)
+      measured = measured->next;
+    if(_gid_junit.is_per_config)
+    {
+      _gid_write_junit_case(
+        test,
+        regression->configuration,
+        0,
+        GID_RUN_RESULT_FAILED,
+        regression,
+        regression->next);
+    }
+    _gid_write_event_failure(test, regression);
+    _gid_fail_results_record(
+      measured->record_index,
+      regression,
+      regression->next);
+  }
+  _gid_add_test_failures(test, regressions);
+  _gid_free_arena(&regressionArena);
+  _gid_finish_failure_groups(test);
+
+  if(test->pass_config_count + test->skip_config_count
+      == test->total_config_count)
+    test->status = GID_TEST_PASSED;
+  else
+    test->status = GID_TEST_FAILED;
+  test->is_complete = 1;
+  if(!_gid_junit.is_per_config)
+  {
+    GIDRunResult result = GID_RUN_RESULT_PASSED;
+    if(test->status == GID_TEST_FAILED)
+      result = GID_RUN_RESULT_FAILED;
+    else if(test->pass_config_count == 0)
+      result = GID_RUN_RESULT_SKIPPED;
+    _gid_write_junit_case(
+      test,
+      NULL,
+      test->total_runtime,
+      result,
+      test->first_failure,
+      NULL);
+  }
+  _gid_write_event_test_end(test);
+  _gid_print_test_status(test);
+  printf("\n");
+  fflush(stdout);
+  _gid_progress.is_showing = 0;
+}
+
+/* Fails a test whose number of configurations doesn't fit in 64 bits, since
+ * its configurations can't be numbered. None of them are run, and the test
+ * counts as one failed configuration.
+ * @param suite - Pointer to the GIDTestSuite that contains the test.
+ * @param test - Pointer to the GIDTest, whose 'total_config_count' must
+ *        already be 1. */
+void _gid_fail_config_overflow(const GIDTestSuite* suite, GIDTest* test)
+{
+  _gid_pre_test(test);
+  GIDArena arena;
+  memset(&arena, 0, sizeof(GIDArena));
+  GIDTestFailure* failure = _gid_create_test_failure(
+    &arena,
+    test->name,
+    "",
+    0,
+    "The test has 2^64 or more configurations, which can't be numbered.",
+    test->source_file,
+    test->line,
+    GID_STEP_RUN);
+  if(_gid_junit.is_per_config)
+    _gid_write_junit_case(test, NULL, 0, GID_RUN_RESULT_FAILED, failure, NULL);
+  _gid_write_event_failure(test, failure);
+  _gid_write_results_record(test, 0, GID_RUN_RESULT_FAILED, 0, failure, NULL);
+  _gid_add_test_failures(test, failure);
+  _gid_free_arena(&arena);
+  _gid_post_test(suite, test);
+}
+
+/* Prepares to run a specific configuration of a test.
+ * @param test - Pointer to the GIDTest.
+ * @param run - Pointer to the GIDTestRun that is about to run. */
+void _gid_pre_test_config_run(GIDTest* test, GIDTestRun* run)
+{
+  test->run_config_count++;
+  _gid_report_progress(test);
+}
+
+/* Finalizes a run of a specific configuration of a test.
+ * @param test - Pointer to the GIDTest.
+ * @param run - Pointer to the GIDTestRun that has finished. */
+void _gid_post_test_config_run(GIDTest* test, GIDTestRun* run)
+{
+  switch(run->run_result)
+  {
+    case GID_RUN_RESULT_FAILED:
+      test->status = GID_TEST_FAILED;
+      break;
+
+    case GID_RUN_RESULT_PENDING:
+    case GID_RUN_RESULT_SKIPPED:
+      test->skip_config_count++;
+      break;
+
+    case GID_RUN_RESULT_PASSED:
+      test->pass_config_count++;
+      break;
+  }
+
+  test->total_runtime += run->runtime;
+  _gid_add_heap_stats(&test->heap, run->configuration_index, run->heap);
+  _gid_report_progress(test);
+}
+
+/* Checks whether the time budget of a test has run out (see the time_budget
+ * of GIDOptions).
+ * @param timer - Pointer to the GIDTimer that measures the budget, or NULL if
+ *        there is no time budget.
+ * @returns - Non-zero if the time budget has run out. */
+int _gid_is_over_budget(const GIDTimer* timer)
+{
+  return timer != NULL
+    && _gid_read_timer(timer) >= (uint64_t)_gid_options.time_budget * 1000000;
+}
+
+/* Fails a run whose run step used more heap than the budgets of its test
+ * (see PeakHeapBudget and AllocCountBudget). Runs that were skipped aren't
+ * checked.
+ * @param test - Pointer to the GIDTest.
+ * @param run - Pointer to the GIDTestRun, which has finished. */
+void _gid_check_heap_budget(const GIDTest* test, GIDTestRun* run)
+{
+  if((test->peak_heap_budget == UINT64_MAX
+      && test->alloc_count_budget == UINT64_MAX)
+    || run->run_result == GID_RUN_RESULT_SKIPPED
+    || run->run_result == GID_RUN_RESULT_PENDING)
+    return;
+
+  //The failures belong to the run step, which is the one that was measured
+  run->step = GID_STEP_RUN;
+  const GIDHeapStats* stats = &run->heap[GID_STEP_RUN];
+  char message[GID_MAX_MESSAGE_LENGTH];
+  if(!_gid_is_heap_counted)
+  {
+    _gid_fail_run(test, run,
+      "The test has a heap budget, but heap allocations are only counted "
+      "when GID_WRAP_MALLOC is defined.",
+      test->source_file,
+      test->line);
+    return;
+  }
+  if(stats->peak_bytes > test->peak_heap_budget)
+  {
+    snprintf(message, GID_MAX_MESSAGE_LENGTH,
+      "The run step had a peak of %"PRIu64" heap bytes, which is over the "
+      "budget of %"PRIu64" bytes.",
+      stats->peak_bytes,
+      test->peak_heap_budget);
+    _gid_fail_run(test, run, message, test->source_file, test->line);
+  }
+  if(stats->alloc_count > test->alloc_count_budget)
+  {
+    snprintf(message, GID_MAX_MESSAGE_LENGTH,
+      "The run step made %"PRIu64" heap allocations, which is over the "
+      "budget of %"PRIu64".",
+      stats->alloc_count,
+      test->alloc_count_budget);
+    _gid_fail_run(test, run, message, test->source_file, test->line);
+  }
+}
+
+/* Runs one configuration of a test, including setup and teardown, measures
+ * its runtime, and checks its heap budgets.
+ * @param suite - Pointer to the GIDTestSuite that contains the test.
+ * @param test - Pointer to the GIDTest to run.
+ * @param run - Pointer to the GIDTestRun, which must already be initialized
+ *        for the configuration by _gid_init_run. */
+void _gid_run_config(GIDTestSuite* suite, GIDTest* test, GIDTestRun* run)
+{
+  GIDTimer timer;
+  _gid_start_timer(&timer);
+  suite->func(test, run);
+  run->runtime = _gid_read_timer(&timer);
+  _gid_check_heap_budget(test, run);
+}
+
+/* Runs all configurations of a test.
+ * @param suite - Pointer to the GIDTestSuite that contains the test.
+ * @param test - Pointer to the GIDTest to run. */
+void _gid_run_test(GIDTestSuite* suite, GIDTest* test)
+{
+  _gid_pre_test(test);
+  //+1 so that nothing is zero-sized, since a test may have no parameters
+  size_t* positions = malloc(sizeof(size_t) * (test->param_count + 1));
+  GIDParamValue* values =
+    malloc(sizeof(GIDParamValue) * (test->param_count + 1));
+  GIDPerfCounters perfCounters;
+  _gid_init_perf_counters(&perfCounters);
+  //Only the groups of the failures are kept, so the memory is reused
+  GIDArena runArena;
+  memset(&runArena, 0, sizeof(GIDArena));
+  GIDTimer budgetTimer;
+  _gid_start_timer(&budgetTimer);
+  const GIDTimer* budget = _gid_options.time_budget > 0 ? &budgetTimer : NULL;
+  uint64_t first = test->first_config_number;
+  uint64_t end = first + test->total_config_count;
+  for(uint64_t number = first; number < end; number++)
+  {
+    if(number != first && _gid_is_over_budget(budget))
+    {
+      //Only count the configurations that were run
+      test->total_config_count = number - first;
+      break;
+    }
+
+    uint64_t index = _gid_select_config_number(
+      test,
+      number,
+      number != first,
+      positions,
+      values);
+
+    GIDTestRun run;
+    _gid_init_run(&run, index, positions, values, &runArena);
+    if(_gid_options.perf_counters)
+      run.perf_counters = &perfCounters;
+    _gid_pre_test_config_run(test, &run);
+    _gid_run_config(suite, test, &run);
+    uint64_t recordIndex = _gid_report_run(
+      test,
+      run.configuration_index,
+      run.run_result,
+      run.runtime,
+      run.first_failure);
+    _gid_add_test_failures(test, run.first_failure);
+    _gid_reset_arena(&runArena);
+    _gid_move_run_benchmark(
+      &test->first_benchmark,
+      &test->last_benchmark,
+      &run,
+      recordIndex);
+    _gid_add_perf_stats(test, &test->perf, run.configuration_index, &run.perf);
+    _gid_post_test_config_run(test, &run);
+  }
+  _gid_close_perf_counters(&perfCounters);
+  _gid_free_arena(&runArena);
+  free(positions);
+  free(values);
+  _gid_post_test(suite, test);
+}
+
+#ifdef _WIN32
+/* A mutual exclusion lock. */
+typedef CRITICAL_SECTION GIDMutex;
+
+/* A condition variable, which threads wait on with a GIDMutex locked. */
+typedef CONDITION_VARIABLE GIDCondition;
+
+/* A thread. */
+typedef HANDLE GIDThread;
+#else
+/* A mutual exclusion lock. */
+typedef pthread_mutex_t GIDMutex;
+
+/* A condition variable, which threads wait on with a GIDMutex locked. */
+typedef pthread_cond_t GIDCondition;
+
+/* A thread. */
+typedef pthread_t GIDThread;
+#endif
+
+/* Initializes a GIDMutex.
+ * @param mutex - Pointer to the GIDMutex to initialize. */
+void _gid_mutex_init(GIDMutex* mutex)
+{
+#ifdef _WIN32
+  InitializeCriticalSection(mutex);
+#else
+  pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+/* Frees the resources of a GIDMutex.
+ * @param mutex - Pointer to the GIDMutex to destroy. */
+void _gid_mutex_destroy(GIDMutex* mutex)
+{
+#ifdef _WIN32
+  DeleteCriticalSection(mutex);
+#else
+  pthread_mutex_destroy(mutex);
+#endif
+}
+
+/* Locks a GIDMutex, waiting until it is available.
+ * @param mutex - Pointer to the GIDMutex to lock. */
+void _gid_mutex_lock(GIDMutex* mutex)
+{
+#ifdef _WIN32
+  EnterCriticalSection(mutex);
+#else
+  pthread_mutex_lock(mutex);
+#endif
+}
+
+/* Unlocks a GIDMutex.
+ * @param mutex - Pointer to the GIDMutex to unlock. */
+void _gid_mutex_unlock(GIDMutex* mutex)
+{
+#ifdef _WIN32
+  LeaveCriticalSection(mutex);
+#else
+  pthread_mutex_unlock(mutex);
+#endif
+}
+
+/* Initializes a GIDCondition.
+ * @param cond - Pointer to the GIDCondition to initialize. */
+void _gid_condition_init(GIDCondition* cond)
+{
+#ifdef _WIN32
+  InitializeConditionVariable(cond);
+#else
+  pthread_cond_init(cond, NULL);
+#endif
+}
+
+/* Frees the resources of a GIDCondition.
+ * @param cond - Pointer to the GIDCondition to destroy. */
+void _gid_condition_destroy(GIDCondition* cond)
+{
+#ifdef _WIN32
+  (void)cond;//Windows condition variables don't need to be destroyed
+#else
+  pthread_cond_destroy(cond);
+#endif
+}
+
+/* Unlocks a GIDMutex and waits until a GIDCondition is signalled (or a
+ * spurious wakeup happens), then locks the GIDMutex again.
+ * @param cond - Pointer to the GIDCondition to wait on.
+ * @param mutex - Pointer to the GIDMutex, which must be locked. */
+void _gid_condition_wait(GIDCondition* cond, GIDMutex* mutex)
+{
+#ifdef _WIN32
+  SleepConditionVariableCS(cond, mutex, INFINITE);
+#else
+  pthread_cond_wait(cond, mutex);
+#endif
+}
+
+/* Wakes every thread that is waiting on a GIDCondition.
+ * @param cond - Pointer to the GIDCondition. */
+void _gid_condition_broadcast(GIDCondition* cond)
+{
+#ifdef _WIN32
+  WakeAllConditionVariable(cond);
+#else
+  pthread_cond_broadcast(cond);
+#endif
+}
+
+/* Gets the number of processors that are available.
+ * @returns - The number of processors, which is at least one. */
+int32_t _gid_processor_count()
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  int32_t ret = (int32_t)info.dwNumberOfProcessors;
+#else
+  int32_t ret = (int32_t)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  return ret > 0 ? ret : 1;
+}
+
+/* Defines a range of configurations of a test, which a worker thread runs
+ * as one unit of work. */
+typedef struct GIDTask
+{
+  /* The index of the test in the 'tests' array of the GIDPool. */
+  size_t test_index;
+
+  /* The number of the first configuration in the range (see
+   * _gid_get_config_index). */
+  uint64_t begin;
+
+  /* The number just past the last configuration in the range. */
+  uint64_t end;
+} GIDTask;
+
+/* Contains the results of test runs that haven't been added to their
+ * GIDTest yet. */
+typedef struct GIDRunTally
+{
+  /* The number of configurations that passed. */
+  uint64_t pass_config_count;
+
+  /* The number of configurations that were run. */
+  uint64_t run_config_count;
+
+  /* The number of configurations that were skipped. */
+  uint64_t skip_config_count;
+
+  /* The total runtime of the configurations, in nanoseconds. */
+  uint64_t total_runtime;
+
+  /* The number of configurations that were not run because the time budget
+   * of the test ran out. */
+  uint64_t drop_config_count;
+
+  /* Did any configuration fail? Non-zero means yes. */
+  int has_failure;
+
+  /* Pointer to the GIDTestFailure of the first failure, or NULL. */
+  GIDTestFailure* first_failure;
+
+  /* Pointer to the GIDTestFailure of the last failure, or NULL. */
+  GIDTestFailure* last_failure;
+
+  /* The GIDArena of the failures, which is freed once they are added to the
+   * groups of the test. */
+  GIDArena failure_arena;
+
+  /* Pointer to the first GIDBenchmarkResult, or NULL. */
+  GIDBenchmarkResult* first_benchmark;
+
+  /* Pointer to the last GIDBenchmarkResult, or NULL. */
+  GIDBenchmarkResult* last_benchmark;
+
+  /* The hardware performance counters of the configurations. */
+  GIDPerfTally perf;
+
+  /* The heap allocations of the configurations. */
+  GIDHeapTally heap;
+} GIDRunTally;
+
+/* The failures of a range of configurations of a test in a GIDPool, which
+ * are held back until the failures of every lower configuration number have
+ * been added to the groups of the test. Failures are grouped in the order of
+ * their configuration numbers, as they are by _gid_run_test, so which causes
+ * get a group doesn't depend on the order that the workers finish. */
+typedef struct GIDPendingFailures
+{
+  /* The number of the first configuration in the range. */
+  uint64_t begin;
+
+  /* The number just past the last configuration in the range. */
+  uint64_t end;
+
+  /* Pointer to the GIDTestFailure of the first failure that hasn't been
+   * added to the groups of the test, or NULL. */
+  GIDTestFailure* first_failure;
+
+  /* The GIDArena of the failures. */
+  GIDArena failure_arena;
+
+  /* Pointer to the GIDPendingFailures of the next range, or NULL. */
+  struct GIDPendingFailures* next;
+} GIDPendingFailures;
+
+/* Contains the state of a test that is being run by a GIDPool. Tests that
+ * have no configurations to run are left out of the pool. */
+typedef struct GIDPoolTest
+{
+  /* Pointer to the GIDTest. */
+  GIDTest* test;
+
+  /* The number of configurations that haven't finished running. */
+  uint64_t remaining_config_count;
+
+  /* Tasks that contain more configurations than this are split in half, so
+   * that idle workers have something to steal. */
+  uint64_t grain;
+
+  /* Measures the time budget of the test from when its first task started.
+   * This is protected by the lock of the GIDPool. */
+  GIDTimer budget;
+
+  /* Has 'budget' been started? Non-zero means yes. This is protected by the
+   * lock of the GIDPool. */
+  int is_budget_started;
+
+  /* The failures of every configuration numbered below this have been
+   * added to the groups of the test. */
+  uint64_t failure_number;
+
+  /* The ranges of configurations above 'failure_number' that have finished,
+   * ordered by number, or NULL. */
+  GIDPendingFailures* first_pending;
+} GIDPoolTest;
+
+/* Contains the state of a worker thread in a GIDPool. Each worker has a
+ * deque of tasks: the worker pushes and pops tasks at the back, and other
+ * workers steal tasks from the front when they run out of their own. */
+typedef struct GIDWorker
+{
+  /* Pointer to the GIDPool that owns this worker. */
+  struct GIDPool* pool;
+
+  /* Protects the task deque of this worker. */
+  GIDMutex lock;
+
+  /* The task deque of this worker. */
+  GIDTask* tasks;
+
+  /* The index of the task at the front of the deque. */
+  size_t task_front;
+
+  /* The index just past the task at the back of the deque. */
+  size_t task_back;
+
+  /* The number of elements allocated for the 'tasks' array. */
+  size_t task_capacity;
+
+  /* The position of each parameter for the run of this worker, indexed by
+   * slot. */
+  size_t* positions;
+
+  /* The value of each parameter for the run of this worker, indexed by slot. */
+  GIDParamValue* values;
+
+  /* The results of the task that this worker is running. */
+  GIDRunTally tally;
+
+  /* The hardware performance counters of the thread of this worker. */
+  GIDPerfCounters perf_counters;
+
+  /* The thread of this worker. The first worker runs on the thread that
+   * called gidunit(), so this isn't used for it. */
+  GIDThread thread;
+} GIDWorker;
+
+/* Contains the state of a pool of worker threads that run the tests of a
+ * test suite in parallel. */
+typedef struct GIDPool
+{
+  /* Pointer to the GIDTestSuite being run. */
+  GIDTestSuite* suite;
+
+  /* The workers of this pool. */
+  GIDWorker* workers;
+
+  /* The number of workers in this pool. */
+  int32_t worker_count;
+
+  /* The tests of the suite, in the same order as they are defined. */
+  GIDPoolTest* tests;
+
+  /* The number of tests in the suite. */
+  size_t test_count;
+
+  /* Protects the GIDTests, and the fields of the pool that follow. */
+  GIDMutex lock;
+
+  /* The number of configurations of all tests that haven't finished
+   * running. */
+  uint64_t remaining_config_count;
+
+  /* The index of the next test whose result will be printed. Results are
+   * printed in the order that the tests are defined, regardless of the order
+   * in which they finish. */
+  size_t next_report;
+
+  /* Counts the tasks that have been pushed, so an idle worker can tell if
+   * a task was pushed since it last looked for one. */
+  uint64_t push_count;
+
+  /* The number of workers that are waiting on 'work_ready'. */
+  int32_t idle_worker_count;
+
+  /* Signalled when a task is pushed, or when every configuration has
+   * finished running. Idle workers wait on this with 'lock' locked. */
+  GIDCondition work_ready;
+} GIDPool;
+
+/* Pushes a task to the back of the deque of a worker.
+ * @param worker - Pointer to the GIDWorker.
+ * @param task - The GIDTask to push. */
+void _gid_push_task(GIDWorker* worker, GIDTask task)
+{
+  _gid_mutex_lock(&worker->lock);
+  if(worker->task_back == worker->task_capacity)
+  {
+    if(worker->task_front > 0)
+    {
+      //Move the tasks to the start of the array to reuse the space
+      size_t count = worker->task_back - worker->task_front;
+      memmove(
+        worker->tasks,
+        worker->tasks + worker->task_front,
+        sizeof(GIDTask) * count);
+      worker->task_front = 0;
+      worker->task_back = count;
+    }
+    else
+    {
+      worker->task_capacity =
+        worker->task_capacity > 0 ? worker->task_capacity * 2 : 16;
+      worker->tasks = realloc(
+        worker->tasks,
+        sizeof(GIDTask) * worker->task_capacity);
+    }
+  }
+  worker->tasks[worker->task_back] = task;
+  worker->task_back++;
+  _gid_mutex_unlock(&worker->lock);
+
+  //Wake the idle workers, so they can steal the task
+  GIDPool* pool = worker->pool;
+  _gid_mutex_lock(&pool->lock);
+  pool->push_count++;
+  if(pool->idle_worker_count > 0)
+    _gid_condition_broadcast(&pool->work_ready);
+  _gid_mutex_unlock(&pool->lock);
+}
+
+/* Pops a task from the back of the deque of a worker. This is done by the
+ * worker itself, so it runs the task that it pushed most recently.
+ * @param worker - Pointer to the GIDWorker.
+ * @param dst - Pointer to the GIDTask that will receive the task.
+ * @returns - Non-zero if a task was popped, or zero if the deque is empty. */
+int _gid_pop_task(GIDWorker* worker, GIDTask* dst)
+{
+  int ret = 0;
+  _gid_mutex_lock(&worker->lock);
+  if(worker->task_back > worker->task_front)
+  {
+    worker->task_back--;
+    *dst = worker->tasks[worker->task_back];
+    ret = 1;
+  }
+  _gid_mutex_unlock(&worker->lock);
+  return ret;
+}
+
+/* Steals a task from the front of the deque of another worker. The front
+ * holds the oldest, and therefore largest, tasks.
+ * @param worker - Pointer to the GIDWorker that wants a task.
+ * @param dst - Pointer to the GIDTask that will receive the task.
+ * @returns - Non-zero if a task was stolen, or zero if the deques of all
+ *          other workers are empty. */
+int _gid_steal_task(GIDWorker* worker, GIDTask* dst)
+{
+  GIDPool* pool = worker->pool;
+  int32_t self = (int32_t)(worker - pool->workers);
+  for(int32_t i = 1; i < pool->worker_count; i++)
+  {
+    GIDWorker* victim = &pool->workers[(self + i) % pool->worker_count];
+    int ret = 0;
+    _gid_mutex_lock(&victim->lock);
+    if(victim->task_back > victim->task_front)
+    {
+      *dst = victim->tasks[victim->task_front];
+      victim->task_front++;
+      ret = 1;
+    }
+    _gid_mutex_unlock(&victim->lock);
+    if(ret)
+      return 1;
+  }
+  return 0;
+}
+
+/* Joins the GIDPendingFailures of a range to the one of the range just
+ * below it, if at most one of them has failures that haven't been added.
+ * @param lower - Pointer to the GIDPendingFailures of the lower range.
+ * @param upper - Pointer to the GIDPendingFailures of the upper range, which
+ *        is freed if the ranges are joined.
+ * @returns - Non-zero if the ranges were joined. */
+int _gid_join_pending_failures(
+  GIDPendingFailures* lower,
+  GIDPendingFailures* upper)
+{
+  if(lower->end != upper->begin
+    || (lower->first_failure != NULL && upper->first_failure != NULL))
+  {
+    return 0;
+  }
+  if(upper->first_failure != NULL)
+  {
+    lower->first_failure = upper->first_failure;
+    lower->failure_arena = upper->failure_arena;
+  }
+  lower->end = upper->end;
+  lower->next = upper->next;
+  free(upper);
+  return 1;
+}
+
+/* Adds the failures of a range of configurations of a test in a GIDPool to
+ * the groups of the test, in the order of their configuration numbers (see
+ * GIDPendingFailures). The caller must hold the lock of the pool.
+ * @param entry - Pointer to the GIDPoolTest of the test.
+ * @param tally - Pointer to the GIDRunTally of the range, whose failures are
+ *        either added and freed, or held back.
+ * @param begin - The number of the first configuration in the range.
+ * @param end - The number just past the last configuration in the range. */
+void _gid_add_pool_failures(
+  GIDPoolTest* entry,
+  GIDRunTally* tally,
+  uint64_t begin,
+  uint64_t end)
+{
+  GIDTest* test = entry->test;
+  if(begin == entry->failure_number
+    || _gid_can_add_failures_early(test, tally->first_failure))
+  {
+    _gid_add_test_failures(test, tally->first_failure);
+    _gid_free_arena(&tally->failure_arena);
+    tally->first_failure = NULL;
+  }
+
+  if(begin != entry->failure_number)
+  {
+    //Hold the range back until the ranges below it have finished
+    GIDPendingFailures* pending = malloc(sizeof(GIDPendingFailures));
+    pending->begin = begin;
+    pending->end = end;
+    pending->first_failure = tally->first_failure;
+    pending->failure_arena = tally->failure_arena;
+    GIDPendingFailures** pos = &entry->first_pending;
+    GIDPendingFailures* prev = NULL;
+    while(*pos != NULL && (*pos)->begin < begin)
+    {
+      prev = *pos;
+      pos = &(*pos)->next;
+    }
+    pending->next = *pos;
+    *pos = pending;
+    if(pending->next != NULL)
+      _gid_join_pending_failures(pending, pending->next);
+    if(prev != NULL)
+      _gid_join_pending_failures(prev, pending);
+    return;
+  }
+
+  entry->failure_number = end;
+  while(entry->first_pending != NULL
+    && entry->first_pending->begin == entry->failure_number)
+  {
+    GIDPendingFailures* pending = entry->first_pending;
+    _gid_add_test_failures(test, pending->first_failure);
+    _gid_free_arena(&pending->failure_arena);
+    entry->failure_number = pending->end;
+    entry->first_pending = pending->next;
+    free(pending);
+  }
+}
+
+/* Adds the results in a GIDRunTally to a test, and prints the results of any
+ * tests that have finished, in the order that they are defined. The caller
+ * must hold the lock of the pool.
+ * @param pool - Pointer to the GIDPool.
+ * @param entry - Pointer to the GIDPoolTest of the test.
+ * @param tally - Pointer to the GIDRunTally, which will be reset.
+ * @param begin - The number of the first configuration in the tally.
+ * @param end - The number just past the last configuration in the tally. */
+void _gid_merge_tally(
+  GIDPool* pool,
+  GIDPoolTest* entry,
+  GIDRunTally* tally,
+  uint64_t begin,
+  uint64_t end)
+{
+  GIDTest* test = entry->test;
+  test->pass_config_count += tally->pass_config_count;
+  test->run_config_count += tally->run_config_count;
+  test->skip_config_count += tally->skip_config_count;
+  test->total_runtime += tally->total_runtime;
+  _gid_merge_heap_tally(&test->heap, &tally->heap);
+  test->total_config_count -= tally->drop_config_count;
+  if(tally->has_failure)
+    test->status = GID_TEST_FAILED;
+  _gid_add_pool_failures(entry, tally, begin, end);
+  if(tally->first_benchmark != NULL)
+  {
+    if(test->first_benchmark == NULL)
+      test->first_benchmark = tally->first_benchmark;
+    else
+      test->last_benchmark->next = tally->first_benchmark;
+    test->last_benchmark = tally->last_benchmark;
+  }
+  _gid_merge_perf_tally(test, &tally->perf);
+  memset(tally, 0, sizeof(GIDRunTally));
+
+  entry->remaining_config_count -= end - begin;
+  pool->remaining_config_count -= end - begin;
+  if(pool->remaining_config_count == 0 && pool->idle_worker_count > 0)
+    _gid_condition_broadcast(&pool->work_ready);
+
+  if(entry == &pool->tests[pool->next_report])
+    _gid_report_progress(test);
+  while(pool->next_report < pool->test_count
+    && pool->tests[pool->next_report].remaining_config_count == 0)
+  {
+    _gid_post_test(pool->suite, pool->tests[pool->next_report].test);
+
+    pool->next_report++;
+    if(pool->next_report < pool->test_count)
+      _gid_pre_test(pool->tests[pool->next_report].test);
+  }
+}
+
+/* Gets the GIDTimer that measures the time budget of a test in a pool,
+ * starting it if no task of the test has started yet. The caller must hold
+ * the lock of the pool.
+ * @param entry - Pointer to the GIDPoolTest of the test.
+ * @returns - Pointer to the GIDTimer, which stays valid until the pool is
+ *          freed, or NULL if there is no time budget. */
+const GIDTimer* _gid_get_budget_timer(GIDPoolTest* entry)
+{
+  if(_gid_options.time_budget <= 0)
+    return NULL;
+  if(!entry->is_budget_started)
+  {
+    _gid_start_timer(&entry->budget);
+    entry->is_budget_started = 1;
+  }
+  return &entry->budget;
+}
+
+/* Runs the configurations of a task on a worker. If the time budget of the
+ * test runs out, the rest of the configurations are dropped.
+ * @param worker - Pointer to the GIDWorker.
+ * @param task - Pointer to the GIDTask to run. */
+void _gid_run_task(GIDWorker* worker, const GIDTask* task)
+{
+  GIDPool* pool = worker->pool;
+  GIDPoolTest* entry = &pool->tests[task->test_index];
+  GIDRunTally* tally = &worker->tally;
+  _gid_mutex_lock(&pool->lock);
+  const GIDTimer* budget = _gid_get_budget_timer(entry);
+  _gid_mutex_unlock(&pool->lock);
+  for(uint64_t number = task->begin; number < task->end; number++)
+  {
+    if(_gid_is_over_budget(budget))
+    {
+      tally->drop_config_count = task->end - number;
+      break;
+    }
+
+    uint64_t index = _gid_select_config_number(
+      entry->test,
+      number,
+      number != task->begin,
+      worker->positions,
+      worker->values);
+
+    GIDTestRun run;
+    _gid_init_run(
+      &run,
+      index,
+      worker->positions,
+      worker->values,
+      &tally->failure_arena);
+    if(_gid_options.perf_counters)
+      run.perf_counters = &worker->perf_counters;
+    _gid_run_config(pool->suite, entry->test, &run);
+    uint64_t recordIndex = UINT64_MAX;
+    if(_gid_is_run_reported())
+    {
+      _gid_mutex_lock(&pool->lock);
+      recordIndex = _gid_report_run(
+        entry->test,
+        run.configuration_index,
+        run.run_result,
+        run.runtime,
+        run.first_failure);
+      _gid_mutex_unlock(&pool->lock);
+    }
+    _gid_move_run_failures(&tally->first_failure, &tally->last_failure, &run);
+    _gid_move_run_benchmark(
+      &tally->first_benchmark,
+      &tally->last_benchmark,
+      &run,
+      recordIndex);
+    _gid_add_perf_stats(
+      entry->test,
+      &tally->perf,
+      run.configuration_index,
+      &run.perf);
+
+    tally->run_config_count++;
+    switch(run.run_result)
+    {
+      case GID_RUN_RESULT_FAILED:
+        tally->has_failure = 1;
+        break;
+
+      case GID_RUN_RESULT_PENDING:
+      case GID_RUN_RESULT_SKIPPED:
+        tally->skip_config_count++;
+        break;
+
+      case GID_RUN_RESULT_PASSED:
+        tally->pass_config_count++;
+        break;
+    }
+    tally->total_runtime += run.runtime;
+    _gid_add_heap_stats(&tally->heap, run.configuration_index, run.heap);
+  }
+
+  _gid_mutex_lock(&pool->lock);
+  _gid_merge_tally(pool, entry, tally, task->begin, task->end);
+  _gid_mutex_unlock(&pool->lock);
+}
+
+/* The main loop of a worker. The worker runs its own tasks, then steals
+ * tasks from other workers, until every configuration has finished running.
+ * A worker that finds no task waits until one is pushed.
+ * @param worker - Pointer to the GIDWorker. */
+void _gid_worker_main(GIDWorker* worker)
+{
+  GIDPool* pool = worker->pool;
+  while(1)
+  {
+    //Tasks pushed after this are noticed, even if the search misses them
+    _gid_mutex_lock(&pool->lock);
+    uint64_t pushCount = pool->push_count;
+    _gid_mutex_unlock(&pool->lock);
+
+    GIDTask task;
+    if(_gid_pop_task(worker, &task) || _gid_steal_task(worker, &task))
+    {
+      //Keep half of a large task, and leave the other half to be stolen
+      uint64_t grain = pool->tests[task.test_index].grain;
+      while(task.end - task.begin > grain)
+      {
+        GIDTask upper = task;
+        upper.begin = task.begin + (task.end - task.begin) / 2;
+        task.end = upper.begin;
+        _gid_push_task(worker, upper);
+      }
+      _gid_run_task(worker, &task);
+    }
+    else
+    {
+      _gid_mutex_lock(&pool->lock);
+      pool->idle_worker_count++;
+      while(pool->remaining_config_count > 0
+        && pool->push_count == pushCount)
+        _gid_condition_wait(&pool->work_ready, &pool->lock);
+      pool->idle_worker_count--;
+      uint64_t remaining = pool->remaining_config_count;
+      _gid_mutex_unlock(&pool->lock);
+      if(remaining == 0)
+        break;
+    }
+  }
+}
+
+#ifdef _WIN32
+/* Entry point of a worker thread.
+ * @param arg - Pointer to the GIDWorker.
+ * @returns - Zero. */
+DWORD WINAPI _gid_worker_thread(LPVOID arg)
+{
+  _gid_worker_main(arg);
+  return 0;
+}
+#else
+/* Entry point of a worker thread.
+ * @param arg - Pointer to the GIDWorker.
+ * @returns - NULL. */
+void* _gid_worker_thread(void* arg)
+{
+  _gid_worker_main(arg);
+  return NULL;
+}
+#endif
+
+/* Initializes a GIDPool for the tests of a suite, without any workers.
+ * @param pool - Pointer to the GIDPool to initialize.
+ * @param suite - Pointer to the GIDTestSuite, whose tests must already be
+ *        registered.
+ * @param workerCount - The number of workers that will run the tests, which
+ *        determines how finely the tests are divided into tasks.
+ * @returns - The largest number of parameters in any test of the suite. */
+size_t _gid_init_pool(GIDPool* pool, GIDTestSuite* suite, int32_t workerCount)
+{
+  pool->suite = suite;
+  pool->workers = NULL;
+  pool->worker_count = 0;
+  pool->test_count = 0;
+  pool->remaining_config_count = 0;
+  pool->next_report = 0;
+  pool->push_count = 0;
+  pool->idle_worker_count = 0;
+  _gid_mutex_init(&pool->lock);
+  _gid_condition_init(&pool->work_ready);
+
+  size_t maxParamCount = 0;
+  for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+  {
+    if(test->total_config_count == 0 || test->has_config_overflow)
+      continue;//Not in this shard, or already failed
+    pool->test_count++;
+    if(test->param_count > maxParamCount)
+      maxParamCount = test->param_count;
+  }
+
+  pool->tests = malloc(sizeof(GIDPoolTest) * (pool->test_count + 1));
+  size_t i = 0;
+  for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+  {
+    if(test->total_config_count == 0 || test->has_config_overflow)
+      continue;
+    GIDPoolTest* entry = &pool->tests[i++];
+    entry->test = test;
+    entry->is_budget_started = 0;
+    entry->failure_number = test->first_config_number;
+    entry->first_pending = NULL;
+    entry->remaining_config_count = test->total_config_count;
+    entry->grain = entry->remaining_config_count / (workerCount * 8);
+    if(entry->grain < 1)
+      entry->grain = 1;
+    if(entry->grain > 4096)
+      entry->grain = 4096;
+    pool->remaining_config_count += entry->remaining_config_count;
+  }
+  return maxParamCount;
+}
+
+/* Frees the memory of a GIDPool that was initialized by _gid_init_pool.
+ * @param pool - Pointer to the GIDPool. */
+void _gid_free_pool(GIDPool* pool)
+{
+  for(size_t i = 0; i < pool->test_count; i++)
+  {
+    while(pool->tests[i].first_pending != NULL)
+    {
+      GIDPendingFailures* pending = pool->tests[i].first_pending;
+      pool->tests[i].first_pending = pending->next;
+      _gid_free_arena(&pending->failure_arena);
+      free(pending);
+    }
+  }
+  free(pool->tests);
+  _gid_mutex_destroy(&pool->lock);
+  _gid_condition_destroy(&pool->work_ready);
+}
+
+/* Initializes a GIDWorker with an empty task deque.
+ * @param worker - Pointer to the GIDWorker to initialize.
+ * @param pool - Pointer to the GIDPool that owns the worker.
+ * @param maxParamCount - The largest number of parameters in any test. */
+void _gid_init_worker(GIDWorker* worker, GIDPool* pool, size_t maxParamCount)
+{
+  worker->pool = pool;
+  _gid_mutex_init(&worker->lock);
+  worker->tasks = NULL;
+  worker->task_front = 0;
+  worker->task_back = 0;
+  worker->task_capacity = 0;
+  worker->positions = malloc(sizeof(size_t) * (maxParamCount + 1));
+  worker->values = malloc(sizeof(GIDParamValue) * (maxParamCount + 1));
+  memset(&worker->tally, 0, sizeof(GIDRunTally));
+  _gid_init_perf_counters(&worker->perf_counters);
+}
+
+/* Frees the memory of a GIDWorker that was initialized by _gid_init_worker.
+ * @param worker - Pointer to the GIDWorker. */
+void _gid_free_worker(GIDWorker* worker)
+{
+  _gid_mutex_destroy(&worker->lock);
+  free(worker->tasks);
+  free(worker->positions);
+  free(worker->values);
+  _gid_close_perf_counters(&worker->perf_counters);
+}
+
+/* Runs all configurations of all tests in a suite on a pool of worker
+ * threads. Each test starts as one task, and tasks are split as workers
+ * steal them. The results are the same as if the tests were run one at a
+ * time by _gid_run_test, except for the runtimes.
+ * @param suite - Pointer to the GIDTestSuite, whose tests must already be
+ *        registered.
+ * @param workerCount - The number of worker threads, including the calling
+ *        thread. */
+void _gid_run_suite_parallel(GIDTestSuite* suite, int32_t workerCount)
+{
+  GIDPool pool;
+  size_t maxParamCount = _gid_init_pool(&pool, suite, workerCount);
+  pool.worker_count = workerCount;
+  pool.workers = malloc(sizeof(GIDWorker) * workerCount);
+  for(int32_t w = 0; w < workerCount; w++)
+    _gid_init_worker(&pool.workers[w], &pool, maxParamCount);
+
+  //Deal the tests to the workers
+  for(size_t i = 0; i < pool.test_count; i++)
+  {
+    GIDTask task;
+    task.test_index = i;
+    task.begin = pool.tests[i].test->first_config_number;
+    task.end = task.begin + pool.tests[i].remaining_config_count;
+    _gid_push_task(&pool.workers[i % workerCount], task);
+  }
+
+  if(pool.test_count > 0)
+    _gid_pre_test(pool.tests[0].test);
+  for(int32_t w = 1; w < workerCount; w++)
+  {
+#ifdef _WIN32
+    pool.workers[w].thread =
+      CreateThread(NULL, 0, _gid_worker_thread, &pool.workers[w], 0, NULL);
+#else
+    pthread_create(
+      &pool.workers[w].thread,
+      NULL,
+      _gid_worker_thread,
+      &pool.workers[w]);
+#endif
+  }
+  _gid_worker_main(&pool.workers[0]);
+  for(int32_t w = 1; w < workerCount; w++)
+  {
+#ifdef _WIN32
+    WaitForSingleObject(pool.workers[w].thread, INFINITE);
+    CloseHandle(pool.workers[w].thread);
+#else
+    pthread_join(pool.workers[w].thread, NULL);
+#endif
+  }
+
+  for(int32_t w = 0; w < workerCount; w++)
+    _gid_free_worker(&pool.workers[w]);
+  free(pool.workers);
+  _gid_free_pool(&pool);
+}
+
+#ifndef _WIN32
+/* Contains the result of one configuration, as sent by a worker process to
+ * the parent process. Each record is followed by 'failure_count' failure
+ * records. */
+typedef struct GIDRunRecord
+{
+  /* The zero-based index of the configuration. */
+  uint64_t configuration_index;
+
+  /* The result of the run. */
+  GIDRunResult run_result;
+
+  /* The runtime of the run, in nanoseconds. */
+  uint64_t runtime;
+
+  /* The number of failure records that follow this record. */
+  uint32_t failure_count;
+
+  /* Non-zero if 'benchmark' holds the measurement of a Benchmark. */
+  uint32_t has_benchmark;
+
+  /* The measurement, if the test is a Benchmark. */
+  GIDBenchmarkStats benchmark;
+
+  /* The hardware performance counters of the run step, whose mask is zero if
+   * they weren't measured. */
+  GIDPerfStats perf;
+
+  /* The heap allocations of each step, indexed by GIDTestStep. */
+  GIDHeapStats heap[3];
+} GIDRunRecord;
+
+/* Contains a failure of a run, as sent by a worker process to the parent
+ * process. Each record is followed by the configuration, message and source
+ * file strings, without null terminators. */
+typedef struct GIDFailureRecord
+{
+  /* The GIDTestStep in which the failure happened. */
+  GIDTestStep step;
+
+  /* The line in the source file where the failure was detected. */
+  int32_t line;
+
+  /* The length of the configuration string. */
+  uint32_t configuration_length;
+
+  /* The length of the message. */
+  uint32_t message_length;
+
+  /* The length of the source file name. */
+  uint32_t source_file_length;
+} GIDFailureRecord;
+
+/* Contains the state of a worker process that runs tasks for the parent
+ * process. */
+typedef struct GIDProcess
+{
+  /* The process ID of the worker, or zero if there is no worker. */
+  pid_t pid;
+
+  /* The pipe to which the parent writes the tasks of the worker. */
+  int task_fd;
+
+  /* The pipe from which the parent reads the results of the worker. */
+  int result_fd;
+
+  /* Is the worker running a task? Non-zero means yes. */
+  int is_busy;
+
+  /* The task that the worker is running, if it is busy. */
+  GIDTask task;
+
+  /* The number of the next configuration whose result is expected. If the
+   * worker dies, this is the configuration that it was running. */
+  uint64_t next_number;
+
+  /* Measures the time since the configuration 'next_number' started (or
+   * rather, since the result of the one before it was read). */
+  GIDTimer config_timer;
+
+  /* Non-zero if the worker was killed because a configuration ran for longer
+   * than the timeout of its test. */
+  int timed_out;
+
+  /* The number of the configuration that timed out, if 'timed_out' is
+   * non-zero. */
+  uint64_t timeout_number;
+
+  /* Holds the results that have been read but not yet parsed. */
+  uint8_t* buffer;
+
+  /* The number of bytes in 'buffer'. */
+  size_t buffer_size;
+
+  /* The number of bytes allocated for 'buffer'. */
+  size_t buffer_capacity;
+} GIDProcess;
+
+/* Writes an entire buffer to a file descriptor.
+ * @param fd - The file descriptor.
+ * @param src - The buffer to write.
+ * @param size - The number of bytes to write.
+ * @returns - Non-zero if all bytes were written, otherwise zero. */
+int _gid_write_all(int fd, const void* src, size_t size)
+{
+  const uint8_t* bytes = src;
+  while(size > 0)
+  {
+    ssize_t written = write(fd, bytes, size);
+    if(written < 0 && errno == EINTR)
+      continue;
+    if(written <= 0)
+      return 0;
+    bytes += written;
+    size -= written;
+  }
+  return 1;
+}
+
+/* Reads an entire buffer from a file descriptor.
+ * @param fd - The file descriptor.
+ * @param dst - The destination buffer.
+ * @param size - The number of bytes to read.
+ * @returns - Non-zero if all bytes were read, otherwise zero (such as when
+ *          the other end of a pipe was closed). */
+int _gid_read_all(int fd, void* dst, size_t size)
+{
+  uint8_t* bytes = dst;
+  while(size > 0)
+  {
+    ssize_t count = read(fd, bytes, size);
+    if(count < 0 && errno == EINTR)
+      continue;
+    if(count <= 0)
+      return 0;
+    bytes += count;
+    size -= count;
+  }
+  return 1;
+}
+
+/* Sends the result of a run from a worker process to the parent process.
+ * @param fd - The pipe to the parent process.
+ * @param run - Pointer to the GIDTestRun that has finished.
+ * @returns - Non-zero if the result was sent, otherwise zero. */
+int _gid_send_run_record(int fd, const GIDTestRun* run)
+{
+  GIDRunRecord record;
+  record.configuration_index = run->configuration_index;
+  record.run_result = run->run_result;
+  record.runtime = run->runtime;
+  record.failure_count = 0;
+  record.has_benchmark = run->benchmark.is_complete;
+  record.benchmark = run->benchmark.stats;
+  record.perf = run->perf;
+  memcpy(record.heap, run->heap, sizeof(record.heap));
+
+  size_t size = sizeof(GIDRunRecord);
+  for(GIDTestFailure* f = run->first_failure; f != NULL; f = f->next)
+  {
+    record.failure_count++;
+    size += sizeof(GIDFailureRecord) + strlen(f->configuration)
+      + strlen(f->message) + strlen(f->source_file);
+  }
+
+  //Build the whole message first, so it is sent with one write
+  uint8_t* buffer = malloc(size);
+  size_t pos = 0;
+  memcpy(buffer, &record, sizeof(GIDRunRecord));
+  pos += sizeof(GIDRunRecord);
+  for(GIDTestFailure* f = run->first_failure; f != NULL; f = f->next)
+  {
+    GIDFailureRecord failure;
+    failure.step = f->step;
+    failure.line = f->line;
+    failure.configuration_length = strlen(f->configuration);
+    failure.message_length = strlen(f->message);
+    failure.source_file_length = strlen(f->source_file);
+    memcpy(buffer + pos, &failure, sizeof(GIDFailureRecord));
+    pos += sizeof(GIDFailureRecord);
+    memcpy(buffer + pos, f->configuration, failure.configuration_length);
+    pos += failure.configuration_length;
+    memcpy(buffer + pos, f->message, failure.message_length);
+    pos += failure.message_length;
+    memcpy(buffer + pos, f->source_file, failure.source_file_length);
+    pos += failure.source_file_length;
+  }
+
+  int ret = _gid_write_all(fd, buffer, size);
+  free(buffer);
+  return ret;
+}
+
+/* Parses the result of a run that was sent by a worker process, and adds it
+ * to a GIDRunTally.
+ * @param src - The received bytes.
+ * @param size - The number of received bytes.
+ * @param test - Pointer to the GIDTest that was run.
+ * @param tally - Pointer to the GIDRunTally to which to add the result.
+ * @returns - The number of bytes that were parsed, or zero if the record
+ *          hasn't been received completely yet. */
+size_t _gid_parse_run_record(
+  const uint8_t* src,
+  size_t size,
+  const GIDTest* test,
+  GIDRunTally* tally)
+{
+  GIDRunRecord record;
+  if(size < sizeof(GIDRunRecord))
+    return 0;
+  memcpy(&record, src, sizeof(GIDRunRecord));
+
+  //Make sure that the whole record has arrived before using any of it
+  size_t pos = sizeof(GIDRunRecord);
+  for(uint32_t i = 0; i < record.failure_count; i++)
+  {
+    GIDFailureRecord failure;
+    if(size < pos + sizeof(GIDFailureRecord))
+      return 0;
+    memcpy(&failure, src + pos, sizeof(GIDFailureRecord));
+    pos += sizeof(GIDFailureRecord) + failure.configuration_length
+      + failure.message_length + failure.source_file_length;
+    if(size < pos)
+      return 0;
+  }
+
+  pos = sizeof(GIDRunRecord);
+  GIDTestFailure* firstCreated = NULL;
+  for(uint32_t i = 0; i < record.failure_count; i++)
+  {
+    GIDFailureRecord failure;
+    memcpy(&failure, src + pos, sizeof(GIDFailureRecord));
+    pos += sizeof(GIDFailureRecord);
+
+    //The strings were bounded by these lengths when the worker made them
+    char config[GID_MAX_CONFIGURATION_STRING_LENGTH];
+    size_t len = failure.configuration_length < sizeof(config)
+      ? failure.configuration_length
+      : sizeof(config) - 1;
+    memcpy(config, src + pos, len);
+    config[len] = '\0';
+    pos += failure.configuration_length;
+    char message[GID_MAX_MESSAGE_LENGTH];
+    len = failure.message_length < sizeof(message)
+      ? failure.message_length
+      : sizeof(message) - 1;
+    memcpy(message, src + pos, len);
+    message[len] = '\0';
+    pos += failure.message_length;
+    const char* srcFile = _gid_intern_string(
+      (const char*)src + pos,
+      failure.source_file_length);
+    pos += failure.source_file_length;
+
+    GIDTestFailure* created = _gid_create_test_failure(
+      &tally->failure_arena,
+      test->name,
+      config,
+      record.configuration_index,
+      message,
+      srcFile,
+      failure.line,
+      failure.step);
+
+    if(firstCreated == NULL)
+      firstCreated = created;
+    if(tally->first_failure == NULL)
+      tally->first_failure = created;
+    else
+      tally->last_failure->next = created;
+    tally->last_failure = created;
+  }
+  uint64_t recordIndex = _gid_report_run(
+    test,
+    record.configuration_index,
+    record.run_result,
+    record.runtime,
+    firstCreated);
+
+  tally->run_config_count++;
+  switch(record.run_result)
+  {
+    case GID_RUN_RESULT_FAILED:
+      tally->has_failure = 1;
+      break;
+
+    case GID_RUN_RESULT_PENDING:
+    case GID_RUN_RESULT_SKIPPED:
+      tally->skip_config_count++;
+      break;
+
+    case GID_RUN_RESULT_PASSED:
+      tally->pass_config_count++;
+      break;
+  }
+  tally->total_runtime += record.runtime;
+  _gid_add_heap_stats(&tally->heap, record.configuration_index, record.heap);
+  if(record.has_benchmark && record.run_result == GID_RUN_RESULT_PASSED)
+  {
+    GIDBenchmarkResult* result = _gid_create_benchmark_result(
+      record.configuration_index,
+      &record.benchmark,
+      recordIndex);
+    if(tally->first_benchmark == NULL)
+      tally->first_benchmark = result;
+    else
+      tally->last_benchmark->next = result;
+    tally->last_benchmark = result;
+  }
+  _gid_add_perf_stats(
+    test,
+    &tally->perf,
+    record.configuration_index,
+    &record.perf);
+  return pos;
+}
+
+/* The main loop of a worker process. The worker reads tasks from the parent,
+ * runs their configurations, and sends the result of each configuration back
+ * to the parent, until the parent closes the task pipe.
+ * @param pool - Pointer to the GIDPool.
+ * @param maxParamCount - The largest number of parameters in any test.
+ * @param taskFd - The pipe from which tasks are read.
+ * @param resultFd - The pipe to which results are written. */
+void _gid_process_main(
+  GIDPool* pool,
+  size_t maxParamCount,
+  int taskFd,
+  int resultFd)
+{
+  size_t* positions = malloc(sizeof(size_t) * (maxParamCount + 1));
+  GIDParamValue* values =
+    malloc(sizeof(GIDParamValue) * (maxParamCount + 1));
+  GIDPerfCounters perfCounters;
+  _gid_init_perf_counters(&perfCounters);
+  //Each failure is sent as soon as its run finishes, so the memory is reused
+  GIDArena failureArena;
+  memset(&failureArena, 0, sizeof(GIDArena));
+  GIDTask task;
+  while(_gid_read_all(taskFd, &task, sizeof(GIDTask)))
+  {
+    GIDTest* test = pool->tests[task.test_index].test;
+    for(uint64_t number = task.begin; number < task.end; number++)
+    {
+      uint64_t index = _gid_select_config_number(
+        test,
+        number,
+        number != task.begin,
+        positions,
+        values);
+
+      GIDTestRun run;
+      _gid_init_run(&run, index, positions, values, &failureArena);
+      if(_gid_options.perf_counters)
+        run.perf_counters = &perfCounters;
+      _gid_run_config(pool->suite, test, &run);
+      int sent = _gid_send_run_record(resultFd, &run);
+      _gid_reset_arena(&failureArena);
+      if(!sent)
+        break;/*The parent is gone*/
+    }
+  }
+  _gid_close_perf_counters(&perfCounters);
+  _gid_free_arena(&failureArena);
+  free(positions);
+  free(values);
+}
+
+/* Starts a worker process.
+ * @param pool - Pointer to the GIDPool.
+ * @param maxParamCount - The largest number of parameters in any test.
+ * @param processes - The array of all GIDProcesses.
+ * @param processCount - The number of GIDProcesses.
+ * @param proc - Pointer to the GIDProcess to start.
+ * @returns - Non-zero if the worker was started, otherwise zero. */
+int _gid_spawn_process(
+  GIDPool* pool,
+  size_t maxParamCount,
+  GIDProcess* processes,
+  int32_t processCount,
+  GIDProcess* proc)
+{
+  int taskPipe[2];
+  int resultPipe[2];
+  proc->pid = 0;
+  proc->is_busy = 0;
+  proc->timed_out = 0;
+  proc->buffer_size = 0;
+  if(pipe(taskPipe) != 0)
+    return 0;
+  if(pipe(resultPipe) != 0)
+  {
+    close(taskPipe[0]);
+    close(taskPipe[1]);
+    return 0;
+  }
+
+  //Flush now, or the worker would print the parent's buffered output again
+  fflush(NULL);
+  pid_t pid = fork();
+  if(pid == 0)
+  {
+    //Close the pipes of other workers, so they notice when the parent dies
+    for(int32_t i = 0; i < processCount; i++)
+    {
+      if(&processes[i] != proc && processes[i].pid > 0)
+      {
+        close(processes[i].task_fd);
+        close(processes[i].result_fd);
+      }
+    }
+    close(taskPipe[1]);
+    close(resultPipe[0]);
+    _gid_process_main(pool, maxParamCount, taskPipe[0], resultPipe[1]);
+    fflush(NULL);
+    _exit(0);
+  }
+
+  close(taskPipe[0]);
+  close(resultPipe[1]);
+  if(pid < 0)
+  {
+    close(taskPipe[1]);
+    close(resultPipe[0]);
+    return 0;
+  }
+  proc->pid = pid;
+  proc->task_fd = taskPipe[1];
+  proc->result_fd = resultPipe[0];
+  return 1;
+}
+
+/* Stops a worker process after it died or was told to stop, and turns the
+ * configuration that it was running (if any) into a failure.
+ * @param pool - Pointer to the GIDPool.
+ * @param proc - Pointer to the GIDProcess.
+ * @param positions - Buffer for the position of each parameter.
+ * @param values - Buffer for the value of each parameter.
+ * @param retry - Pointer to a GIDTask that receives the configurations of the
+ *        task that were not run.
+ * @returns - Non-zero if 'retry' holds configurations to run again. */
+int _gid_reap_process(
+  GIDPool* pool,
+  GIDProcess* proc,
+  size_t* positions,
+  GIDParamValue* values,
+  GIDTask* retry)
+{
+  close(proc->task_fd);
+  close(proc->result_fd);
+  int status = 0;
+  while(waitpid(proc->pid, &status, 0) < 0 && errno == EINTR);
+  proc->pid = 0;
+  if(!proc->is_busy)
+    return 0;
+  proc->is_busy = 0;
+
+  GIDPoolTest* entry = &pool->tests[proc->task.test_index];
+  retry->test_index = proc->task.test_index;
+  retry->begin = proc->next_number + 1;
+  retry->end = proc->task.end;
+  if(proc->timed_out && proc->timeout_number != proc->next_number)
+  {
+    //The configuration finished just before the worker was killed
+    retry->begin = proc->next_number;
+    return retry->begin < retry->end;
+  }
+
+  char message[GID_MAX_MESSAGE_LENGTH];
+  if(proc->timed_out)
+  {
+    snprintf(message, GID_MAX_MESSAGE_LENGTH,
+      "The test timed out after %i ms.",
+      _gid_get_timeout(entry->test));
+  }
+  else if(WIFSIGNALED(status))
+  {
+    snprintf(message, GID_MAX_MESSAGE_LENGTH,
+      "The test crashed with signal %i (%s).",
+      WTERMSIG(status),
+      strsignal(WTERMSIG(status)));
+  }
+  else
+  {
+    snprintf(message, GID_MAX_MESSAGE_LENGTH,
+      "The test exited with status %i.",
+      WEXITSTATUS(status));
+  }
+
+  char config[GID_MAX_CONFIGURATION_STRING_LENGTH];
+  uint64_t index = _gid_get_config_index(entry->test, proc->next_number);
+  _gid_decode_config_index(entry->test, index, positions, values);
+  _gid_get_params_string(
+    entry->test->first_param,
+    positions,
+    config,
+    GID_MAX_CONFIGURATION_STRING_LENGTH);
+
+  GIDRunTally tally;
+  memset(&tally, 0, sizeof(GIDRunTally));
+  tally.run_config_count = 1;
+  tally.total_runtime = _gid_read_timer(&proc->config_timer);
+  tally.has_failure = 1;
+  tally.first_failure = _gid_create_test_failure(
+    &tally.failure_arena,
+    entry->test->name,
+    config,
+    index,
+    message,
+    entry->test->source_file,
+    entry->test->line,
+    GID_STEP_RUN);
+  tally.last_failure = tally.first_failure;
+  _gid_report_run(
+    entry->test,
+    index,
+    GID_RUN_RESULT_FAILED,
+    tally.total_runtime,
+    tally.first_failure);
+  _gid_merge_tally(
+    pool,
+    entry,
+    &tally,
+    proc->next_number,
+    proc->next_number + 1);
+  return retry->begin < retry->end;
+}
+
+/* Kills a worker process if the configuration that it is running has run for
+ * longer than the timeout of its test (see _gid_get_timeout). The worker is
+ * reaped later, when the parent reads the end of its results.
+ * @param pool - Pointer to the GIDPool.
+ * @param proc - Pointer to the GIDProcess.
+ * @returns - The number of milliseconds until the configuration times out, or
+ *          -1 if it can't time out. */
+int32_t _gid_watch_process(GIDPool* pool, GIDProcess* proc)
+{
+  if(!proc->is_busy || proc->timed_out)
+    return -1;
+  int32_t timeout = _gid_get_timeout(pool->tests[proc->task.test_index].test);
+  if(timeout == 0)
+    return -1;
+
+  uint64_t limit = (uint64_t)timeout * 1000000;
+  uint64_t elapsed = _gid_read_timer(&proc->config_timer);
+  if(elapsed < limit)
+    return (int32_t)((limit - elapsed + 999999) / 1000000);//Round up
+  kill(proc->pid, SIGKILL);
+  proc->timed_out = 1;
+  proc->timeout_number = proc->next_number;
+  return -1;
+}
+
+/* Drops a task without running it if the time budget of its test has run
+ * out. Worker processes don't check the time budget themselves, so the
+ * budget is only checked before each task is given to a worker.
+ * @param pool - Pointer to the GIDPool.
+ * @param task - Pointer to the GIDTask.
+ * @returns - Non-zero if the task was dropped. */
+int _gid_drop_task_over_budget(GIDPool* pool, const GIDTask* task)
+{
+  GIDPoolTest* entry = &pool->tests[task->test_index];
+  if(!_gid_is_over_budget(_gid_get_budget_timer(entry)))
+    return 0;
+
+  GIDRunTally tally;
+  memset(&tally, 0, sizeof(GIDRunTally));
+  tally.drop_config_count = task->end - task->begin;
+  _gid_merge_tally(pool, entry, &tally, task->begin, task->end);
+  return 1;
+}
+
+/* Runs all configurations of all tests in a suite on a pool of worker
+ * processes. A configuration that crashes its worker (or makes it exit)
+ * fails, the worker is replaced, and the rest of the suite keeps running.
+ * The results are printed in the same order as they would be by
+ * _gid_run_test.
+ * @param suite - Pointer to the GIDTestSuite, whose tests must already be
+ *        registered.
+ * @param processCount - The number of worker processes. */
+void _gid_run_suite_processes(GIDTestSuite* suite, int32_t processCount)
+{
+  GIDPool pool;
+  size_t maxParamCount = _gid_init_pool(&pool, suite, processCount);
+
+  //Split the tests into tasks, in order
+  size_t taskCount = 0;
+  size_t taskCapacity = 16;
+  size_t nextTask = 0;
+  GIDTask* tasks = malloc(sizeof(GIDTask) * taskCapacity);
+  for(size_t i = 0; i < pool.test_count; i++)
+  {
+    uint64_t first = pool.tests[i].test->first_config_number;
+    uint64_t total = first + pool.tests[i].remaining_config_count;
+    for(uint64_t begin = first; begin < total; begin += pool.tests[i].grain)
+    {
+      if(taskCount == taskCapacity)
+      {
+        taskCapacity *= 2;
+        tasks = realloc(tasks, sizeof(GIDTask) * taskCapacity);
+      }
+      tasks[taskCount].test_index = i;
+      tasks[taskCount].begin = begin;
+      tasks[taskCount].end = begin + pool.tests[i].grain < total
+        ? begin + pool.tests[i].grain
+        : total;
+      taskCount++;
+    }
+  }
+
+  //Configurations that must run again after a crash
+  size_t retryCount = 0;
+  GIDTask* retries = malloc(sizeof(GIDTask) * processCount);
+
+  //Writing to a dead worker must fail rather than kill the parent
+  void (*prevSigpipe)(int) = signal(SIGPIPE, SIG_IGN);
+
+  GIDWorker local;
+  _gid_init_worker(&local, &pool, maxParamCount);
+  GIDProcess* processes = calloc(processCount, sizeof(GIDProcess));
+  struct pollfd* fds = malloc(sizeof(struct pollfd) * processCount);
+  for(int32_t i = 0; i < processCount; i++)
+  {
+    _gid_spawn_process(
+      &pool,
+      maxParamCount,
+      processes,
+      processCount,
+      &processes[i]);
+  }
+
+  if(pool.test_count > 0)
+    _gid_pre_test(pool.tests[0].test);
+  while(pool.remaining_config_count > 0)
+  {
+    //Give a task to each idle worker, and watch the busy ones
+    int32_t busyCount = 0;
+    int pollTimeout = -1;
+    for(int32_t i = 0; i < processCount; i++)
+    {
+      GIDProcess* proc = &processes[i];
+      if(proc->pid == 0 && !_gid_spawn_process(
+          &pool,
+          maxParamCount,
+          processes,
+          processCount,
+          proc))
+        continue;
+      if(!proc->is_busy && (retryCount > 0 || nextTask < taskCount))
+      {
+        if(retryCount > 0)
+          proc->task = retries[--retryCount];
+        else
+          proc->task = tasks[nextTask++];
+        if(_gid_drop_task_over_budget(&pool, &proc->task))
+        {
+          i--;//Give this worker another task
+          continue;
+        }
+        proc->next_number = proc->task.begin;
+        proc->is_busy = 1;
+        _gid_start_timer(&proc->config_timer);
+        if(!_gid_write_all(proc->task_fd, &proc->task, sizeof(GIDTask)))
+        {
+          //The worker died before it could start, so run the task again
+          proc->is_busy = 0;
+          retries[retryCount++] = proc->task;
+          _gid_reap_process(&pool, proc, local.positions, local.values, NULL);
+          continue;
+        }
+      }
+      if(proc->is_busy)
+      {
+        int32_t left = _gid_watch_process(&pool, proc);
+        if(left >= 0 && (pollTimeout < 0 || left < pollTimeout))
+          pollTimeout = left;
+        fds[busyCount].fd = proc->result_fd;
+        fds[busyCount].events = POLLIN;
+        fds[busyCount].revents = 0;
+        busyCount++;
+      }
+    }
+
+    if(busyCount == 0)
+    {
+      //No worker could be started, so run the rest in this process
+      GIDTask task;
+      while(retryCount > 0 || nextTask < taskCount)
+      {
+        task = retryCount > 0 ? retries[--retryCount] : tasks[nextTask++];
+        _gid_run_task(&local, &task);
+      }
+      break;
+    }
+
+    if(poll(fds, busyCount, pollTimeout) < 0)
+      continue;
+
+    for(int32_t i = 0; i < processCount; i++)
+    {
+      GIDProcess* proc = &processes[i];
+      if(!proc->is_busy)
+        continue;
+      int32_t f = 0;
+      while(fds[f].fd != proc->result_fd)
+        f++;
+      if(fds[f].revents == 0)
+        continue;
+
+      if(proc->buffer_capacity - proc->buffer_size < 4096)
+      {
+        proc->buffer_capacity = proc->buffer_capacity * 2 + 4096;
+        proc->buffer = realloc(proc->buffer, proc->buffer_capacity);
+      }
+      ssize_t count = read(
+        proc->result_fd,
+        proc->buffer + proc->buffer_size,
+        proc->buffer_capacity - proc->buffer_size);
+      if(count < 0 && errno == EINTR)
+        continue;
+      if(count <= 0)
+      {
+        GIDTask retry;
+        if(_gid_reap_process(&pool, proc, local.positions, local.values,
+          &retry))
+          retries[retryCount++] = retry;
+        continue;
+      }
+      proc->buffer_size += count;
+
+      //Add all of the complete results to the test at once
+      GIDPoolTest* entry = &pool.tests[proc->task.test_index];
+      GIDRunTally tally;
+      memset(&tally, 0, sizeof(GIDRunTally));
+      size_t pos = 0;
+      size_t parsed;
+      uint64_t runCount = 0;
+      while((parsed = _gid_parse_run_record(
+        proc->buffer + pos,
+        proc->buffer_size - pos,
+        entry->test,
+        &tally)) > 0)
+      {
+        pos += parsed;
+        runCount++;
+      }
+      memmove(proc->buffer, proc->buffer + pos, proc->buffer_size - pos);
+      proc->buffer_size -= pos;
+      uint64_t begin = proc->next_number;
+      proc->next_number += runCount;
+      if(runCount > 0)
+        _gid_start_timer(&proc->config_timer);
+      if(proc->next_number == proc->task.end)
+        proc->is_busy = 0;
+      if(runCount > 0)
+        _gid_merge_tally(&pool, entry, &tally, begin, proc->next_number);
+    }
+  }
+
+  //Closing the task pipes tells the workers to exit
+  for(int32_t i = 0; i < processCount; i++)
+  {
+    if(processes[i].pid > 0)
+      _gid_reap_process(&pool, &processes[i], NULL, NULL, NULL);
+    free(processes[i].buffer);
+  }
+  signal(SIGPIPE, prevSigpipe);
+
+  free(fds);
+  free(processes);
+  _gid_free_worker(&local);
+  free(retries);
+  free(tasks);
+  _gid_free_pool(&pool);
+}
+#endif
+
+/* Sets one option. The names of the options are the same as the environment
+ * variables without the 'GID_' prefix:
+ *   THREADS - The number of threads that run the configurations of the
+ *   tests. Zero (or a negative number) means one thread per processor. The
+ *   default is 1, so the tests run on the calling thread.
+ *   PROCESSES - The number of worker processes that run the configurations
+ *   of the tests, so a crash only fails the configuration that crashed. Zero
+ *   (or a negative number) means one process per processor. By default, no
+ *   worker processes are used. This takes precedence over THREADS, and is not
+ *   supported on Windows.
+ *   SHARD_INDEX - The zero-based index of the shard to run.
+ *   SHARD_COUNT - The number of shards. The configurations of all tests are
+ *   split into this many contiguous slices of (nearly) equal size, and only
+ *   the slice selected by SHARD_INDEX is run. The default is 1.
+ *   COVERAGE_STRENGTH - Runs a covering array of this strength for each test
+ *   (see _gid_build_covering_array) instead of every combination of
+ *   parameters. For example, 2 tests every pair of values of every two
+ *   parameters. A test can choose its own strength with CoveringArray. The
+ *   default is 0, which runs every combination.
+ *   SAMPLE_COUNT - Runs a random sample of this many configurations of each
+ *   test that has more (see _gid_select_sample). The default is 0, which runs
+ *   every configuration.
+ *   TIME_BUDGET - The time budget of each test, in milliseconds. The
+ *   configurations are run in random order until the budget runs out, and
+ *   the rest are not run. The default is 0, which means no limit.
+ *   SEED - The seed of the random order used by SAMPLE_COUNT and
+ *   TIME_BUDGET. The default is based on the current time. The seed is
+ *   printed, so a run can be repeated exactly.
+ *   TIMEOUT - The longest time that each configuration may run, in
+ *   milliseconds. A configuration that runs for longer fails, and the rest
+ *   keep running. A test can choose its own timeout with Timeout. Since a
+ *   stuck configuration can only be stopped by killing its process, suites
+ *   with a timeout run in worker processes (one per thread, if PROCESSES
+ *   isn't set). The default is 0, which means no limit. Not supported on
+ *   Windows.
+ *   BENCHMARK_TIME - The time that each measured batch of iterations of a
+ *   Benchmark should take, in milliseconds. Longer batches give steadier
+ *   measurements. The default is 10.
+ *   BASELINE - The path of a file with the baseline measurement of each
+ *   configuration of each Benchmark (see _gid_check_baseline). A
+ *   configuration that is slower than its baseline by more than
+ *   REGRESSION_THRESHOLD fails. Configurations without a baseline are added
+ *   to the file. By default, there is no baseline.
+ *   REGRESSION_THRESHOLD - How much slower than its baseline a configuration
+ *   may be, as a percentage. A Benchmark can choose its own threshold with
+ *   RegressionThreshold. The default is 20.
+ *   UPDATE_BASELINE - Non-zero to replace the measurements in the BASELINE
+ *   file with the new ones, instead of comparing them. The default is 0.
+ *   PERF_COUNTERS - Non-zero to measure hardware performance counters, such
+ *   as cycles, instructions and cache misses, during the run step of each
+ *   configuration. They are summed for each test, and broken down by the
+ *   values of its parameters, in the summary. The default is 0. Only
+ *   supported on Linux.
+ *   PROGRESS_RATE - The most times per second that the status of the running
+ *   test is updated on the terminal. Zero only prints each test when it
+ *   finishes, which is always the case when stdout isn't a terminal. The
+ *   default is 10.
+ *   JUNIT - The path of a JUnit XML report to write as the tests run, with a
+ *   test case for each test. By default, no report is written.
+ *   JUNIT_PER_CONFIG - Non-zero to write a test case for each configuration
+ *   in the JUnit XML report instead. The default is 0.
+ *   EVENTS - The path of a file to which events (such as the result of each
+ *   configuration) are written as they happen, as one JSON object per line.
+ *   By default, no events are written.
+ *   EVENTS_FD - A file descriptor to which the events are written instead,
+ *   if EVENTS isn't set, such as 3 for a pipe that the caller opened.
+ *   RESULTS - The path of a binary results file to write, with a fixed-size
+ *   record for the result of each configuration (see GIDResultsHeader), which
+ *   stays compact and quick to query when there are millions of them. By
+ *   default, no results file is written.
+ * @param name - The name of the option.
+ * @param value - The value of the option. Nothing happens if this is NULL or
+ *        empty. */
+void _gid_set_option(const char* name, const char* value)
+{
+  if(value == NULL || value[0] == '\0')
+    return;
+
+  if(strcmp(name, "THREADS") == 0)
+  {
+    _gid_options.thread_count = atoi(value);
+    if(_gid_options.thread_count <= 0)
+      _gid_options.thread_count = _gid_processor_count();
+  }
+  else if(strcmp(name, "PROCESSES") == 0)
+  {
+    _gid_options.process_count = atoi(value);
+    if(_gid_options.process_count <= 0)
+      _gid_options.process_count = _gid_processor_count();
+  }
+  else if(strcmp(name, "SHARD_INDEX") == 0)
+  {
+    _gid_options.shard_index = atoi(value);
+  }
+  else if(strcmp(name, "SHARD_COUNT") == 0)
+  {
+    _gid_options.shard_count = atoi(value);
+  }
+  else if(strcmp(name, "COVERAGE_STRENGTH") == 0)
+  {
+    _gid_options.coverage_strength = atoi(value);
+  }
+  else if(strcmp(name, "SAMPLE_COUNT") == 0)
+  {
+    _gid_options.sample_count = strtoull(value, NULL, 10);
+  }
+  else if(strcmp(name, "TIME_BUDGET") == 0)
+  {
+    _gid_options.time_budget = atoi(value);
+  }
+  else if(strcmp(name, "SEED") == 0)
+  {
+    _gid_options.seed = strtoull(value, NULL, 10);
+  }
+  else if(strcmp(name, "TIMEOUT") == 0)
+  {
+    _gid_options.timeout = atoi(value);
+  }
+  else if(strcmp(name, "BENCHMARK_TIME") == 0)
+  {
+    _gid_options.benchmark_time = atoi(value);
+    if(_gid_options.benchmark_time < 1)
+      _gid_options.benchmark_time = 1;
+  }
+  else if(strcmp(name, "BASELINE") == 0)
+  {
+    _gid_options.baseline_path = value;
+  }
+  else if(strcmp(name, "REGRESSION_THRESHOLD") == 0)
+  {
+    _gid_options.regression_threshold = atoi(value);
+    if(_gid_options.regression_threshold < 0)
+      _gid_options.regression_threshold = 0;
+  }
+  else if(strcmp(name, "UPDATE_BASELINE") == 0)
+  {
+    _gid_options.update_baseline = atoi(value) != 0;
+  }
+  else if(strcmp(name, "PERF_COUNTERS") == 0)
+  {
+    _gid_options.perf_counters = atoi(value) != 0;
+  }
+  else if(strcmp(name, "PROGRESS_RATE") == 0)
+  {
+    _gid_options.progress_rate = atoi(value);
+    if(_gid_options.progress_rate < 0)
+      _gid_options.progress_rate = 0;
+  }
+  else if(strcmp(name, "JUNIT") == 0)
+  {
+    _gid_options.junit_path = value;
+  }
+  else if(strcmp(name, "JUNIT_PER_CONFIG") == 0)
+  {
+    _gid_options.junit_per_config = atoi(value) != 0;
+  }
+  else if(strcmp(name, "EVENTS") == 0)
+  {
+    _gid_options.events_path = value;
+  }
+  else if(strcmp(name, "EVENTS_FD") == 0)
+  {
+    _gid_options.events_fd = atoi(value);
+  }
+  else if(strcmp(name, "RESULTS") == 0)
+  {
+    _gid_options.results_path = value;
+  }
+}
+
+/* Resets the options to their defaults, then reads them from the
+ * environment variables (see _gid_set_option), such as GID_THREADS. */
+void _gid_read_options()
+{
+  _gid_options.thread_count = 1;
+  _gid_options.process_count = 0;
+  _gid_options.shard_index = 0;
+  _gid_options.shard_count = 1;
+  _gid_options.coverage_strength = 0;
+  _gid_options.sample_count = 0;
+  _gid_options.time_budget = 0;
+  _gid_options.seed = _gid_mix64((uint64_t)time(NULL));
+  _gid_options.timeout = 0;
+  _gid_options.benchmark_time = 10;
+  _gid_options.baseline_path = NULL;
+  _gid_options.regression_threshold = 20;
+  _gid_options.update_baseline = 0;
+  _gid_options.perf_counters = 0;
+  _gid_options.progress_rate = 10;
+  _gid_options.junit_path = NULL;
+  _gid_options.junit_per_config = 0;
+  _gid_options.events_path = NULL;
+  _gid_options.events_fd = -1;
+  _gid_options.results_path = NULL;
+
+  _gid_set_option("THREADS", getenv("GID_THREADS"));
+  _gid_set_option("PROCESSES", getenv("GID_PROCESSES"));
+  _gid_set_option("SHARD_INDEX", getenv("GID_SHARD_INDEX"));
+  _gid_set_option("SHARD_COUNT", getenv("GID_SHARD_COUNT"));
+  _gid_set_option("COVERAGE_STRENGTH", getenv("GID_COVERAGE_STRENGTH"));
+  _gid_set_option("SAMPLE_COUNT", getenv("GID_SAMPLE_COUNT"));
+  _gid_set_option("TIME_BUDGET", getenv("GID_TIME_BUDGET"));
+  _gid_set_option("SEED", getenv("GID_SEED"));
+  _gid_set_option("TIMEOUT", getenv("GID_TIMEOUT"));
+  _gid_set_option("BENCHMARK_TIME", getenv("GID_BENCHMARK_TIME"));
+  _gid_set_option("BASELINE", getenv("GID_BASELINE"));
+  _gid_set_option("REGRESSION_THRESHOLD", getenv("GID_REGRESSION_THRESHOLD"));
+  _gid_set_option("UPDATE_BASELINE", getenv("GID_UPDATE_BASELINE"));
+  _gid_set_option("PERF_COUNTERS", getenv("GID_PERF_COUNTERS"));
+  _gid_set_option("PROGRESS_RATE", getenv("GID_PROGRESS_RATE"));
+  _gid_set_option("JUNIT", getenv("GID_JUNIT"));
+  _gid_set_option("JUNIT_PER_CONFIG", getenv("GID_JUNIT_PER_CONFIG"));
+  _gid_set_option("EVENTS", getenv("GID_EVENTS"));
+  _gid_set_option("EVENTS_FD", getenv("GID_EVENTS_FD"));
+  _gid_set_option("RESULTS", getenv("GID_RESULTS"));
+}
+
+/* Reads options from command line arguments, which override the
+ * environment variables. Each option is written as '--gid-name=value', where
+ * the name is the name of the environment variable without the 'GID_'
+ * prefix, in lowercase and with dashes instead of underscores (such as
+ * '--gid-shard-index=3'). Other arguments are ignored.
+ * @param argc - The number of arguments.
+ * @param argv - The arguments, where the first is the program name. */
+void _gid_read_args(int argc, char** argv)
+{
+  const char* prefix = "--gid-";
+  size_t prefixLen = strlen(prefix);
+  for(int i = 1; i < argc; i++)
+  {
+    const char* arg = argv[i];
+    const char* equals = strchr(arg, '=');
+    if(strncmp(arg, prefix, prefixLen) != 0 || equals == NULL)
+      continue;
+
+    char name[64];
+    size_t nameLen = equals - (arg + prefixLen);
+    if(nameLen >= sizeof(name))
+      continue;
+    for(size_t j = 0; j < nameLen; j++)
+    {
+      char c = arg[prefixLen + j];
+      if(c == '-')
+        name[j] = '_';
+      else if(c >= 'a' && c <= 'z')
+        name[j] = c - 'a' + 'A';
+      else
+        name[j] = c;
+    }
+    name[nameLen] = '\0';
+    _gid_set_option(name, equals + 1);
+  }
+}
+
+/* Selects the configurations that this process runs when the tests are split
+ * into shards. All configurations of all registered tests are numbered in
+ * order (by suite, then test, then configuration index), and each shard gets
+ * a contiguous slice of (nearly) equal size, so a test with many
+ * configurations is spread across shards. This updates the
+ * 'first_config_number' and 'total_config_count' of each test.
+ * @param shardIndex - The zero-based index of the shard to run.
+ * @param shardCount - The number of shards.
+ * @param shardConfigCount - Pointer to an integer that will be assigned to
+ *        the number of configurations in the shard.
+ * @returns - Non-zero if the shard was selected. Zero means that the total
+ *          number of configurations of all tests doesn't fit in 64 bits, in
+ *          which case nothing is changed. */
+int _gid_select_shard(
+  uint64_t shardIndex,
+  uint64_t shardCount,
+  uint64_t* shardConfigCount)
 {
-  GIDTest* prev = dst->last_test;
-  dst->last_test = test;
+  uint64_t total = 0;
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      if(test->total_config_count > UINT64_MAX - total)
+        return 0;
+      total += test->total_config_count;
+    }
+  }
 
-  if(dst->first_test == NULL)
-    dst->first_test = test;
-  if(prev != NULL)
-    prev->next = test;
-}
+  //Same as total*index/count, without overflowing
+  uint64_t begin = (total / shardCount) * shardIndex
+    + (total % shardCount) * shardIndex / shardCount;
+  uint64_t end = (total / shardCount) * (shardIndex + 1)
+    + (total % shardCount) * (shardIndex + 1) / shardCount;
 
+  uint64_t offset = 0;
+  for(GIDTestSuite* suite = _gid_first_suite;
+    suite != NULL;
+    suite = suite->next)
+  {
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      uint64_t count = test->total_config_count;
+      uint64_t first = begin > offset ? begin : offset;
+      uint64_t last = end < offset + count ? end : offset + count;
+      if(first < last)
+      {
+        test->first_config_number = first - offset;
+        test->total_config_count = last - first;
+      }
+      else
+      {
+        test->first_config_number = 0;
+        test->total_config_count = 0;
+      }
+      offset += count;
+    }
+  }
+  *shardConfigCount = end - begin;
+  return 1;
+}
 
-/* Clears the current line on stdout. */
-#define _gid_clear_console_line() printf("%c[2k\r", 27)
+/* Checks whether any test in a suite has a timeout (see _gid_get_timeout).
+ * @param suite - Pointer to the GIDTestSuite, whose tests must already be
+ *        registered.
+ * @returns - Non-zero if any test of the suite has a timeout. */
+int _gid_suite_has_timeout(const GIDTestSuite* suite)
+{
+  for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+  {
+    if(_gid_get_timeout(test) > 0 && test->total_config_count > 0)
+      return 1;
+  }
+  return 0;
+}
 
-/* Prints the current status of a test on the lowest line.
- * This will erase the lowest line then overwrite it. */
-void _gid_print_test_status(const GIDTest* test)
+/* Runs all tests defined in each test suite with the current options, and
+ * prints a summary.
+ * @returns - Zero if all tests passed, otherwise non-zero. */
+int _gid_run_all()
 {
-  const char* statusStr = "?";
-  switch(test->status)
+  if(_gid_options.shard_count < 1
+    || _gid_options.shard_index < 0
+    || _gid_options.shard_index >= _gid_options.shard_count)
   {
-    case GID_TEST_PENDING:
-      statusStr = "\033[37;40m IDLE \033[0m";
-      break;
+    printf("Invalid shard %i of %i. The shard index must be at least zero "
+      "and less than the shard count.\n",
+      _gid_options.shard_index,
+      _gid_options.shard_count);
+    _gid_free();
+    return -1;
+  }
 
-    case GID_TEST_RUNNING:
-      statusStr = "\033[30;43m RUN \033[0m";
-      break;
+  _gid_init_progress();
 
-    case GID_TEST_FAILED:
-      statusStr = "\033[30;41m FAIL \033[0m";
-      break;
+  //Register the tests of every suite, so they can be split into shards
+  uint32_t testCount = 0;
+  GIDTestSuite* suite = _gid_first_suite;
+  while(suite != NULL)
+  {
+    suite->func(NULL, NULL);
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      test->index = testCount++;
+      if(test->has_config_overflow)
+      {
+        test->total_config_count = 1;//Counts as one failed configuration
+        continue;
+      }
 
-    case GID_TEST_PASSED:
-      statusStr = "\033[30;42m PASS \033[0m";
-      break;
+      int32_t strength = test->coverage_strength >= 0
+        ? test->coverage_strength
+        : _gid_options.coverage_strength;
+      _gid_build_covering_array(suite->name, test, strength);
+      if(_gid_options.sample_count > 0 || _gid_options.time_budget > 0)
+      {
+        _gid_select_sample(
+          test,
+          suite->name,
+          _gid_options.seed,
+          _gid_options.sample_count);
+      }
+    }
+    suite = suite->next;
   }
 
-
-  _gid_clear_console_line();
-  printf("%s\t%s\t%i/%i configurations passed",
-    statusStr,
-    test->name,
-    test->pass_config_count,
-    test->total_config_count);
-  if(test->skip_config_count > 0)
-    printf("\t(%i skipped)", test->skip_config_count);
-  if(test->is_complete)
+  if(_gid_options.sample_count > 0 || _gid_options.time_budget > 0)
+    printf("Sampling configurations with seed %"PRIu64".\n", _gid_options.seed);
+  if(_gid_options.baseline_path != NULL)
+    _gid_load_baselines();
+  if(_gid_options.perf_counters)
   {
-    int32_t avgMillis = test->total_runtime / test->run_config_count;
-    if(test->total_config_count > 1)
+    //Check once, rather than once for each thread
+    GIDPerfCounters counters;
+    _gid_init_perf_counters(&counters);
+    if(!_gid_open_perf_counters(&counters))
     {
-      printf("\t[%ims total, avg %ims per configuration]",
-        test->total_runtime,
-        avgMillis);
+      printf("Couldn't open the hardware performance counters, so they won't "
+        "be measured.\n");
+      _gid_options.perf_counters = 0;
     }
-    else
+    _gid_close_perf_counters(&counters);
+  }
+  if(_gid_options.perf_counters)
+  {
+    for(suite = _gid_first_suite; suite != NULL; suite = suite->next)
     {
-      printf("\t[%ims]", test->total_runtime);
+      for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+        _gid_init_perf_rows(test);
     }
   }
-  fflush(stdout);
-}
 
-/* Prepares to run a test (before any specific configuration is executed).
- * This will update the status of the test to 'running', and will print the
- * status to stdout.
- * @param test - Pointer to the GIDTest that is being prepared. */
-void _gid_pre_test(GIDTest* test)
-{
-  test->status = GID_TEST_RUNNING;
-  _gid_print_test_status(test);
-}
+  if(_gid_options.shard_count > 1)
+  {
+    uint64_t count = 0;
+    if(!_gid_select_shard(
+      _gid_options.shard_index,
+      _gid_options.shard_count,
+      &count))
+    {
+      printf("The tests have 2^64 or more configurations in total, so they "
+        "can't be split into shards.\n");
+      _gid_free();
+      return -1;
+    }
+    printf("Running shard %i of %i (%"PRIu64" configurations).\n",
+      _gid_options.shard_index,
+      _gid_options.shard_count,
+      count);
+  }
+  if(!_gid_open_junit_report())
+  {
+    printf("Couldn't open the JUnit report %s, so it won't be written.\n",
+      _gid_options.junit_path);
+  }
+  if(!_gid_open_events())
+  {
+    printf("Couldn't open the event stream %s, so it won't be written.\n",
+      _gid_options.events_path);
+  }
+  if(!_gid_open_results())
+  {
+    printf("Couldn't open the results file %s, so it won't be written.\n",
+      _gid_options.results_path);
+  }
 
-/* Finalizes the result of a test after all configurations have been run.
- * This will determine whether the test passed or failed (based on whether
- * any configuration resulted in failure), and will print the status to stdout.
- * @param test - Pointer to the GIDTest that has finished. */
-void _gid_post_test(GIDTest* test)
-{
-  if(test->pass_config_count + test->skip_config_count
-      == test->total_config_count)
-    test->status = GID_TEST_PASSED;
-  else
-    test->status = GID_TEST_FAILED;
-  test->is_complete = 1;
-  _gid_print_test_status(test);
-  printf("\n");
-}
+  suite = _gid_first_suite;
+  while(suite != NULL)
+  {
+    _gid_begin_junit_suite(suite);
+    _gid_write_event_suite_start(suite);
+    for(GIDTest* test = suite->first_test; test != NULL; test = test->next)
+    {
+      if(test->has_config_overflow && test->total_config_count > 0)
+        _gid_fail_config_overflow(suite, test);
+    }
 
-/* Prepares to run a specific configuration of a test.
- * @param test - Pointer to the GIDTest.
- * @param run - Pointer to the GIDTestRun that is about to run. */
-void _gid_pre_test_config_run(GIDTest* test, GIDTestRun* run)
-{
-  test->run_config_count++;
-  _gid_print_test_status(test);
-}
+#ifndef _WIN32
+    if(_gid_options.process_count > 0 && suite->first_test != NULL)
+    {
+      _gid_run_suite_processes(suite, _gid_options.process_count);
+    }
+    else if(_gid_suite_has_timeout(suite))
+    {
+      //Only a worker process can be stopped when a configuration hangs
+      _gid_run_suite_processes(suite, _gid_options.thread_count);
+    }
+    else
+#endif
+    if(_gid_options.thread_count > 1 && suite->first_test != NULL)
+    {
+      _gid_run_suite_parallel(suite, _gid_options.thread_count);
+    }
+    else
+    {
+      GIDTest* test = suite->first_test;
+      while(test != NULL)
+      {
+        if(test->total_config_count > 0 && !test->has_config_overflow)
+          _gid_run_test(suite, test);
+        test = test->next;
+      }
+    }
+    _gid_end_junit_suite();
+    _gid_write_event_suite_end();
+    _gid_end_results_suite();
+    suite = suite->next;
+  }
 
-/* Finalizes a run of a specific configuration of a test.
- * @param test - Pointer to the GIDTest.
- * @param run - Pointer to the GIDTestRun that has finished. */
-void _gid_post_test_config_run(GIDTest* test, GIDTestRun* run)
-{
-  switch(run->run_result)
+  if(_gid_options.baseline_path != NULL && _gid_is_baseline_changed)
   {
-    case GID_RUN_RESULT_FAILED:
-      test->status = GID_TEST_FAILED;
-      break;
+    if(_gid_save_baselines())
+      printf("Saved the benchmark baseline to %s.\n",
+        _gid_options.baseline_path);
+    else
+      printf("Couldn't save the benchmark baseline to %s.\n",
+        _gid_options.baseline_path);
+  }
 
-    case GID_RUN_RESULT_PENDING:
-    case GID_RUN_RESULT_SKIPPED:
-      test->skip_config_count++;
-      break;
+  if(_gid_options.junit_path != NULL && _gid_junit.file != NULL)
+  {
+    if(_gid_close_junit_report())
+      printf("Wrote the JUnit report to %s.\n", _gid_options.junit_path);
+    else
+      printf("Couldn't write the JUnit report to %s.\n",
+        _gid_options.junit_path);
+  }
 
-    case GID_RUN_RESULT_PASSED:
-      test->pass_config_count++;
-      break;
+  if(_gid_options.results_path != NULL && _gid_results.file != NULL)
+  {
+    if(_gid_close_results())
+      printf("Wrote the results to %s.\n", _gid_options.results_path);
+    else
+      printf("Couldn't write the results to %s.\n",
+        _gid_options.results_path);
   }
 
-  test->total_runtime += run->runtime;
-  _gid_print_test_status(test);
+  //Generate the summary
+  int ret = _gid_summary();
+  _gid_close_events();
+  _gid_free();
+  return ret;
 }
 
-/* Structure that contains time tracking data. */
-typedef struct GIDTimer
-{
-#ifdef _WIN32
-  /* The start timestamp, based on GetTickCount(). */
-  int32_t start;
-#else
-  /* The time when the timer started. */
-  struct timeval start;
-#endif
-} GIDTimer;
-
-/* Allocates and starts a GIDTimer.
- * @param test - Pointer to the GIDTest to associate with the timer.
- * @returns - Pointer to the allocated GIDTimer. */
-GIDTimer* _gid_start_timer(const GIDTest* test)
+/* Runs all tests defined in each test suite, and prints a summary. The
+ * options are read from environment variables, such as GID_THREADS.
+ * @returns - Zero if all tests passed, otherwise non-zero. */
+int gidunit()
 {
-  GIDTimer* ret = malloc(sizeof(GIDTimer));
-#ifdef _WIN32
-  ret->start = GetTickCount();
-#else
-  gettimeofday(&ret->start, NULL);
-#endif
-  return ret;
+  _gid_read_options();
+  return _gid_run_all();
 }
 
-/* Stops a GIDTimer and frees its memory.
- * @param timer - Pointer to the GIDTimer to stop.
- * @returns - The total elapsed time of the timer, in milliseconds. */
-int32_t _gid_stop_timer(GIDTimer* timer)
+/* Runs all tests defined in each test suite, and prints a summary. This is
+ * the same as gidunit(), except that options may also be passed as command
+ * line arguments, such as '--gid-shard-index=3 --gid-shard-count=32'.
+ * Arguments that don't start with '--gid-' are ignored.
+ * @param argc - The number of arguments, as passed to main.
+ * @param argv - The arguments, as passed to main.
+ * @returns - Zero if all tests passed, otherwise non-zero. */
+int gidunit_main(int argc, char** argv)
 {
-#ifdef _WIN32
-  int32_t ret = GetTickCount() - timer->start;
-#else
-  struct timeval end;
-  gettimeofday(&end, NULL);
-  struct timeval duration;
-  timersub(&end, &timer->start, &duration);
-  int32_t ret = (duration.tv_sec * 1000) + (duration.tv_usec / 1000);
-#endif
-  free(timer);
-  return ret;
+  _gid_read_options();
+  _gid_read_args(argc, argv);
+  return _gid_run_all();
 }
 
 /* Skips the current test run, giving it no result (neither fail nor pass).
@@ -1722,17 +8454,9 @@ int32_t _gid_stop_timer(GIDTimer* timer)
  * @param ... - Values of the variables in the formatted message. */
 #define assert_fail_format(message, ...)                                      \
 {                                                                             \
-  _gid_cur_run.run_result = GID_RUN_RESULT_FAILED;                            \
   char _gidMsgBuf[GID_MAX_MESSAGE_LENGTH];                                    \
   snprintf(_gidMsgBuf, GID_MAX_MESSAGE_LENGTH, (message), __VA_ARGS__);       \
-  GIDTestFailure* _gidFailure = _gid_create_test_failure(                     \
-    _gid_cur_test->name,                                                      \
-    _gid_cur_run.configuration,                                               \
-    _gidMsgBuf,                                                               \
-    __FILE__,                                                                 \
-    __LINE__,                                                                 \
-    _gid_cur_run.step);                                                       \
-  _gid_add_test_failure(_gid_cur_test, _gidFailure);                          \
+  _gid_fail_run(_gid_cur_test, _gid_cur_run, _gidMsgBuf, __FILE__, __LINE__); \
   goto _GID_TEST_END;                                                         \
 }
 
@@ -1967,59 +8691,125 @@ int32_t _gid_stop_timer(GIDTimer* timer)
       #actual" has the same exact memory as "#unexpected".");                 \
   }
 
+/* Asserts that the heap usage of the current step (such as the run step) has
+ * stayed below a limit so far. The usage is the most bytes that the step has
+ * allocated at once, counting from the start of the step. This needs
+ * GID_WRAP_MALLOC, and fails if it isn't defined.
+ * @param bytes - The limit, in bytes. */
+#define assert_peak_heap_below(bytes)                                         \
+  {                                                                           \
+    uint64_t _gidLimit = (bytes);                                             \
+    uint64_t _gidPeak = _gid_cur_run->heap[_gid_cur_run->step].peak_bytes;    \
+    assert_message(                                                           \
+      _gid_is_heap_counted,                                                   \
+      "Heap allocations are only counted when GID_WRAP_MALLOC is defined.");  \
+    assert_message_format(                                                    \
+      _gidPeak < _gidLimit,                                                   \
+      "The peak heap usage was %"PRIu64" bytes, which isn't below "           \
+      "the limit of %"PRIu64" bytes.",                                        \
+      _gidPeak,                                                               \
+      _gidLimit);                                                             \
+  }
+
+/* Asserts that the current step (such as the run step) has made fewer heap
+ * allocations than a limit so far. Reallocations count as allocations. This
+ * needs GID_WRAP_MALLOC, and fails if it isn't defined.
+ * @param count - The limit on the number of allocations. */
+#define assert_alloc_count_below(count)                                       \
+  {                                                                           \
+    uint64_t _gidLimit = (count);                                             \
+    uint64_t _gidCount = _gid_cur_run->heap[_gid_cur_run->step].alloc_count;  \
+    assert_message(                                                           \
+      _gid_is_heap_counted,                                                   \
+      "Heap allocations are only counted when GID_WRAP_MALLOC is defined.");  \
+    assert_message_format(                                                    \
+      _gidCount < _gidLimit,                                                  \
+      "%"PRIu64" heap allocations were made, which isn't below "              \
+      "the limit of %"PRIu64".",                                              \
+      _gidCount,                                                              \
+      _gidLimit);                                                             \
+  }
+
 
 /* Internal helper macro that allows an optional semicolon at the end. */
 #define _gid_allow_optional_semicolon() {}
 
-/* Macro that reads a parameter into a variable.
+/* Macro that reads a parameter into a variable. Parameters are read in the
+ * same order that they were added to the test, so each read takes the value
+ * from the next slot (see GIDParamBase.slot) of the current run.
  * @param type - The type of the variable.
+ * @param member - The member of the GIDParamValue that holds the value.
  * @param var_name - The name of the variable. */
-#define _gid_read_variable(type, var_name)                                    \
-          {                                                                   \
-            type* _gidValPtr;                                                 \
-            GIDParamBase* _gidParam = _gid_find_param(                        \
-              _gid_cur_test,                                                  \
-              #var_name);                                                     \
-            _gidValPtr = _gid_param_get_value(_gidParam);                     \
-            if(_gidValPtr != NULL)                                            \
-              ((type*)&var_name)[0] = (*_gidValPtr);                          \
-            else                                                              \
-              ((type*)&var_name)[0] = (type)NULL;                             \
-          }
+#define _gid_read_variable(type, member, var_name)                            \
+          ((type*)&var_name)[0] =                                             \
+            (type)_gid_cur_run->param_values[_gid_param_slot++].member;
 
 /* Checks whether the scope containing this line belongs to the test that is
- * currently being executed. This is important because all tests exist in the
- * 'main test loop' at once, but each test has its own local scope. If you
- * didn't check this condition (or other similar conditions), then your code
- * would run for every step of every test configuration.  */
+ * currently being executed. All tests exist in the suite function at once,
+ * but each test has its own local scope, and the suite function jumps
+ * directly into the scope of the running test (see GIDTest.scope). So once
+ * initialization is done, only the scope of the running test can be reached
+ * during the 'run' step. */
 #define _gid_is_this_test_running (_gid_cur_test != NULL                      \
-          && _gid_test_step == GID_STEP_RUN                                   \
-          && strncmp(_gid_cur_test->name,                                     \
-               _gid_scope_test_name,                                          \
-               strlen(_gid_scope_test_name)+1) == 0)
+          && _gid_test_step == GID_STEP_RUN)
 
 /* Checks if initialization is in progress. Initialization is when 'test
  * registration' happens, when _gid_cur_test is NULL and all of the user-
  * defined tests, parameters, and suites are being registered. This happens
- * during the first iteration of the 'main test loop'. */
+ * when gidunit() first calls the suite function, before any test is run. */
 #define _gid_is_initializing (_gid_cur_test == NULL)
 
+/* Marks a deliberate fall through to the next case label, so that
+ * -Wimplicit-fallthrough doesn't warn about it. Compilers without the
+ * attribute get an empty statement instead. */
+#if defined(__has_attribute)
+#if __has_attribute(fallthrough)
+#define _GID_FALLTHROUGH __attribute__((fallthrough))
+#endif
+#endif
+#ifndef _GID_FALLTHROUGH
+#define _GID_FALLTHROUGH
+#endif
+
+/* Leaves the scope that the suite function jumped to, since its body has
+ * finished. Nothing happens during initialization, since every scope must be
+ * walked to register the tests.
+ * @param result - The GIDRunResult to assign to the current test run if it
+ *        is still pending. */
+#define _gid_leave_scope(result)                                              \
+        if(!_gid_is_initializing)                                             \
+        {                                                                     \
+          if(_gid_is_this_test_running                                        \
+             && _gid_cur_run->run_result == GID_RUN_RESULT_PENDING)           \
+            _gid_cur_run->run_result = (result);                              \
+          goto _GID_TEST_END;                                                 \
+        }
+
 /* Ends the scope of a previous test. */
 #define _gid_end_previous_test_scope                                          \
-        if(_gid_is_this_test_running                                          \
-           && _gid_cur_run.run_result == GID_RUN_RESULT_PENDING)              \
-          _gid_cur_run.run_result = GID_RUN_RESULT_PASSED;                    \
+        _gid_leave_scope(GID_RUN_RESULT_PASSED)                               \
       }                                                                       \
       while(0);                                                               \
-      if(_gid_is_this_test_running                                            \
-         && _gid_cur_run.run_result == GID_RUN_RESULT_PENDING)                \
-        _gid_cur_run.run_result = GID_RUN_RESULT_SKIPPED;                     \
+      _gid_leave_scope(GID_RUN_RESULT_SKIPPED)
+
+/* Gets a number that identifies the scope of a Test, SetUp or TearDown. It
+ * is unique within the translation unit, so several of them may share a line,
+ * such as when they are generated by other macros. Zero is the start of the
+ * suite function, so one is added. Without __COUNTER__, the line is used
+ * instead, so each of them must be on its own line. */
+#ifdef __COUNTER__
+#define _gid_unique_scope (__COUNTER__ + 1)
+#else
+#define _gid_unique_scope (__LINE__)
+#endif
 
-/* Starts the scope of a new test. */
-#define _gid_start_next_test_scope(test_name)                                 \
+/* Starts the scope of a new test.
+ * @param scope - Identifies the scope, so the suite function can jump
+ *        directly to it. */
+#define _gid_start_next_test_scope(scope)                                     \
       do                                                                      \
       {                                                                       \
-        _gid_scope_test_name = #test_name;
+        case (scope):;
 
 /* Registers a test suite that you defined by the BEGIN_TEST_SUITE and
  * END_TEST_SUITE macros.
@@ -2091,49 +8881,32 @@ int32_t _gid_stop_timer(GIDTimer* timer)
  * */
 #define BEGIN_TEST_SUITE(suite_name)                                          \
 GIDTestSuite* _gid_test_suite_##suite_name = NULL;                            \
-void _gid_test_suite_func_##suite_name()                                      \
+void _gid_test_suite_func_##suite_name(                                       \
+  GIDTest* _gid_cur_test,                                                     \
+  GIDTestRun* _gid_cur_run)                                                   \
 {                                                                             \
   GIDTestSuite* _gid_test_suite = _gid_test_suite_##suite_name;               \
-                                                                              \
-  GIDTest* _gid_cur_test = NULL;                                              \
   GIDTest* _gid_added_test = NULL;                                            \
-  char* _gid_scope_test_name = NULL;                                          \
-  do                                                                          \
+  void* fixture = NULL;                                                       \
+  (void)fixture;                                                              \
+  for(GIDTestStep _gid_test_step = GID_STEP_SETUP;                            \
+    _gid_test_step <= GID_STEP_TEARDOWN;                                      \
+    _gid_test_step++)                                                         \
   {                                                                           \
-    if(_gid_cur_test != NULL)                                                 \
-      _gid_pre_test(_gid_cur_test);                                           \
-                                                                              \
-    do                                                                        \
+    int _gid_scope = _gid_get_step_scope(                                     \
+      _gid_test_suite,                                                        \
+      _gid_cur_test,                                                          \
+      _gid_test_step);                                                        \
+    if(!_gid_is_initializing)                                                 \
     {                                                                         \
-      void* fixture = NULL;                                                   \
-      (void)fixture;                                                          \
-      GIDTestRun _gid_cur_run = (GIDTestRun)                                  \
-      {                                                                       \
-        .run_result = GID_RUN_RESULT_PENDING,                                 \
-        .step = GID_STEP_SETUP,                                               \
-        .runtime = -1,                                                        \
-      };                                                                      \
-      GIDTimer* _gid_cur_timer = NULL;                                        \
-      if(_gid_cur_test != NULL)                                               \
-      {                                                                       \
-        _gid_get_params_string(                                               \
-          _gid_cur_test->first_param,                                         \
-          _gid_cur_run.configuration,                                         \
-          GID_MAX_CONFIGURATION_STRING_LENGTH);                               \
-        _gid_cur_timer = _gid_start_timer(_gid_cur_test);                     \
-      }                                                                       \
-      else                                                                    \
-      {                                                                       \
-        _gid_cur_run.configuration[0] = '\0';                                 \
-      }                                                                       \
-      for(GIDTestStep _gid_test_step = GID_STEP_SETUP;                        \
-        _gid_test_step <= GID_STEP_TEARDOWN;                                  \
-        _gid_test_step++)                                                     \
-      {                                                                       \
-        _gid_cur_run.step = _gid_test_step;                                   \
-        if(_gid_test_step == GID_STEP_RUN)                                    \
-          _gid_pre_test_config_run(_gid_cur_test, &_gid_cur_run);             \
-        _gid_start_next_test_scope(""/*Start of 'dummy test' scope*/)
+      _gid_cur_run->step = _gid_test_step;                                    \
+      if(_gid_scope == 0)                                                     \
+        continue;/*No SetUp or TearDown to run*/                              \
+      _gid_enter_step(_gid_cur_run);                                          \
+    }                                                                         \
+    switch(_gid_scope)                                                        \
+    {                                                                         \
+      _gid_start_next_test_scope(0/*Start of 'dummy test' scope*/)
 
 /* Defines a setup function for all tests in a test suite.
  * @remarks - You can have at most one SetUp function per test suite. The
@@ -2146,8 +8919,17 @@ void _gid_test_suite_func_##suite_name()                                      \
  *          and any failures will be associated with the proper test.
  *          You will likely need to pass data to the test function, you
  *          can use the 'void* fixture' variable for this purpose. */
-#define SetUp()                                                               \
-        if(_gid_cur_test != NULL && _gid_test_step == GID_STEP_SETUP)
+#define SetUp() _gid_define_setup(_gid_unique_scope)
+
+/* Defines the SetUp function of a test suite.
+ * @param scope - Identifies the scope of the SetUp function. */
+#define _gid_define_setup(scope)                                              \
+        _gid_leave_scope(GID_RUN_RESULT_PASSED)                               \
+        _GID_FALLTHROUGH;                                                     \
+        case scope:                                                           \
+        if(_gid_is_initializing)                                              \
+          _gid_test_suite->setup_scope = scope;                               \
+        else if(_gid_test_step == GID_STEP_SETUP)
         /* SetUp body goes here */
 
 /* Defines a test function.
@@ -2179,19 +8961,28 @@ void _gid_test_suite_func_##suite_name()                                      \
  *          }
  * */
 #define Test(test_name, ...)                                                  \
+        _gid_define_test(_gid_unique_scope, test_name, __VA_ARGS__)
+
+/* Defines a test function.
+ * @param scope - Identifies the scope of the test body.
+ * @param test_name - The name of the test.
+ * @param ... - Definitions of the parameters of the test. */
+#define _gid_define_test(scope, test_name, ...)                               \
         _gid_end_previous_test_scope                                          \
         void* gid_test_##test_name = NULL;/*Unused var to force unique names*/\
         (void)gid_test_##test_name;                                           \
-        _gid_start_next_test_scope(test_name)                                 \
+        _gid_start_next_test_scope(scope)                                     \
         GIDParamBase* _gid_int_row_params = NULL;                             \
         GIDParamBase* _gid_uint_row_params = NULL;                            \
         GIDParamBase* _gid_string_row_params = NULL;                          \
         const int64_t* int_row = NULL;                                        \
         const uint64_t* uint_row = NULL;                                      \
         const char** string_row = NULL;                                       \
+        size_t _gid_param_slot = 0;                                           \
         if(_gid_is_initializing)                                              \
         {                                                                     \
-          _gid_added_test = _gid_create_test(#test_name);                     \
+          _gid_added_test =                                                   \
+            _gid_create_test(#test_name, __FILE__, __LINE__, scope);          \
           _gid_add_test(_gid_test_suite, _gid_added_test);                    \
           _gid_int_row_params =                                               \
             _gid_create_row_param("int_row", GID_ROW_PARAM_TYPE_INT64);       \
@@ -2200,12 +8991,6 @@ void _gid_test_suite_func_##suite_name()                                      \
           _gid_string_row_params =                                            \
             _gid_create_row_param("string_row", GID_ROW_PARAM_TYPE_STRING);   \
         }                                                                     \
-        else if(_gid_is_this_test_running)                                    \
-        {                                                                     \
-          _gid_read_variable(int64_t*, int_row);                              \
-          _gid_read_variable(uint64_t*, uint_row);                            \
-          _gid_read_variable(char**, string_row);                             \
-        }                                                                     \
         __VA_ARGS__                                                           \
         if(_gid_is_initializing)                                              \
         {                                                                     \
@@ -2214,49 +8999,194 @@ void _gid_test_suite_func_##suite_name()                                      \
           _gid_add_param(_gid_added_test, _gid_uint_row_params);              \
           _gid_add_param(_gid_added_test, _gid_string_row_params);            \
         }                                                                     \
+        else                                                                  \
+        {                                                                     \
+          /*Rows are read last, since they are added last */                  \
+          _gid_read_variable(const int64_t*, p, int_row);                     \
+          _gid_read_variable(const uint64_t*, p, uint_row);                   \
+          _gid_read_variable(const char**, p, string_row);                    \
+        }                                                                     \
         if(_gid_is_this_test_running)
         /* Test body goes here */
 
+/* Defines a benchmark, which is a Test whose body is timed. The body is
+ * repeated in batches, and the number of iterations in each batch grows until
+ * a batch takes long enough to time accurately (see the GID_BENCHMARK_TIME
+ * option). Then batches are measured until their times agree, and the time
+ * per iteration, iterations per second, and bytes per second (see
+ * set_bytes_per_op) of each configuration are printed with the summary.
+ * @param test_name - The name that you want to assign to this benchmark.
+ * @param ... - Definitions of parameters, the same as for a Test. Each
+ *        configuration is measured separately.
+ * @remarks - SetUp and TearDown run once per configuration, not once per
+ *          iteration, so the fixture can hold data that every iteration uses.
+ *          A configuration is only measured if it passes, so asserts can be
+ *          used in the body. Don't 'break' out of the body, since that would
+ *          end a batch early. Run benchmarks on one thread, since other
+ *          threads would compete with them.
+ * @example -
+ *
+ *          Benchmark(MemsetSpeed,
+ *            EnumParam(size, 64, 4096, 65536))
+ *          {
+ *            memset(fixture, 0, size);
+ *            set_bytes_per_op(size);
+ *          }
+ * */
+#define Benchmark(test_name, ...)                                             \
+        Test(test_name, __VA_ARGS__)                                          \
+        while(_gid_next_benchmark_batch(&_gid_cur_run->benchmark))            \
+          for(uint64_t _gid_iters_left =                                      \
+                _gid_cur_run->benchmark.stats.iterations;                     \
+            _gid_iters_left > 0;                                              \
+            _gid_iters_left--)
+        /* Benchmark body goes here */
+
+/* Sets the number of bytes that each iteration of a Benchmark processes, so
+ * its throughput is also printed in bytes per second. Use this in the body
+ * of the Benchmark.
+ * @param bytes - The number of bytes that one iteration processes. */
+#define set_bytes_per_op(bytes)                                               \
+  (_gid_cur_run->benchmark.stats.bytes_per_op = (uint64_t)(bytes))
+
 /* Defines a TearDown function for all tests in a particular test suite.
  * @remarks - This TearDown macro must be placed between the
  *          BEGIN_TEST_SUITE and END_TEST_SUITE macros. The body of this
  *          function should be contained by scope brackets {} immediately
  *          following this macro. You may access the 'void* fixture' variable
  *          inside of the TearDown function. */
-#define TearDown()                                                            \
-        if(_gid_cur_test != NULL && _gid_test_step == GID_STEP_TEARDOWN)
+#define TearDown() _gid_define_teardown(_gid_unique_scope)
+
+/* Defines the TearDown function of a test suite.
+ * @param scope - Identifies the scope of the TearDown function. */
+#define _gid_define_teardown(scope)                                           \
+        _gid_leave_scope(GID_RUN_RESULT_PASSED)                               \
+        _GID_FALLTHROUGH;                                                     \
+        case scope:                                                           \
+        if(_gid_is_initializing)                                              \
+          _gid_test_suite->teardown_scope = scope;                            \
+        else if(_gid_test_step == GID_STEP_TEARDOWN)
         /* Teardown body goes here */
 
 /* Marks the end of a test suite. */
 #define END_TEST_SUITE()                                                      \
         _gid_end_previous_test_scope                                          \
-        if(_gid_is_initializing)                                              \
-        {                                                                     \
-          break;/*For init, break on setup*/                                  \
-        }                                                                     \
-        else if(_gid_test_step == GID_STEP_TEARDOWN)                          \
-        {                                                                     \
-          _gid_cur_run.runtime = _gid_stop_timer(_gid_cur_timer);             \
-          _gid_post_test_config_run(_gid_cur_test, &_gid_cur_run);            \
-        }                                                                     \
-        _GID_TEST_END:                                                        \
-        continue;                                                             \
-      }                                                                       \
-    }                                                                         \
-    while(_gid_cur_test != NULL &&_gid_cycle_params(_gid_cur_test));          \
-    if(_gid_cur_test == NULL)                                                 \
-    {                                                                         \
-      _gid_cur_test = _gid_test_suite->first_test;                            \
-    }                                                                         \
-    else                                                                      \
-    {                                                                         \
-      _gid_post_test(_gid_cur_test);                                          \
-      _gid_cur_test = _gid_cur_test->next;                                    \
     }                                                                         \
+    if(_gid_is_initializing)                                                  \
+      break;/*For init, break on setup*/                                      \
+    _GID_TEST_END:                                                            \
+    _gid_leave_step(_gid_cur_run);                                            \
+    continue;                                                                 \
   }                                                                           \
-  while(_gid_cur_test != NULL);                                               \
 }
 
+/* Makes a test run a covering array of its configurations instead of every
+ * combination of parameter values. A covering array of strength N contains
+ * every combination of values of any N parameters, in far fewer
+ * configurations than every combination of all parameters.
+ * @param strength - The strength of the covering array, such as 2 to test
+ *        every pair of values of every two parameters. Zero runs every
+ *        combination, even if the GID_COVERAGE_STRENGTH option is set.
+ * @remarks - Place this macro among the parameters of the Test. If the test
+ *          has no more parameters than the strength, every combination is
+ *          run.
+ * @example -
+ *
+ * Test(MyTestFunc,
+ *   CoveringArray(2)
+ *   RangeParam(a, 0, 9)
+ *   RangeParam(b, 0, 9)
+ *   RangeParam(c, 0, 9)
+ *   RangeParam(d, 0, 9))
+ * {
+ *   //Every pair of values of any two of a, b, c and d is tested, in
+ *   //far fewer than the 10*10*10*10=10000 combinations.
+ * }
+ *
+ * */
+#define CoveringArray(strength)                                               \
+        if(_gid_is_initializing)                                              \
+          _gid_added_test->coverage_strength = (strength);
+
+/* Makes a test run a pairwise covering array, which is a CoveringArray
+ * with a strength of 2. */
+#define Pairwise() CoveringArray(2)
+
+/* Limits how long each configuration of a test may run. A configuration that
+ * runs for longer fails with a message that it timed out, and the rest of
+ * the configurations keep running. Since the stuck configuration is stopped
+ * by killing its process, the suite runs in worker processes (see the
+ * GID_TIMEOUT option).
+ * @param milliseconds - The longest time that each configuration may run.
+ *        Zero means no limit, even if the GID_TIMEOUT option is set.
+ * @remarks - Place this macro among the parameters of the Test.
+ * @example -
+ *
+ * Test(MyTestFunc,
+ *   Timeout(500)
+ *   RangeParam(n, 0, 99))
+ * {
+ *   //Fails any value of n for which this takes more than 500ms
+ *   solve(n);
+ * }
+ *
+ * */
+#define Timeout(milliseconds)                                                 \
+        if(_gid_is_initializing)                                              \
+          _gid_added_test->timeout = (milliseconds);
+
+/* Limits the heap usage of the run step of each configuration of a test. A
+ * configuration whose run step allocated more than this many bytes at once
+ * fails. This needs GID_WRAP_MALLOC, and the test fails if it isn't defined.
+ * @param bytes - The most bytes that may be allocated at once, counting from
+ *        the start of the run step.
+ * @remarks - Place this macro among the parameters of the Test.
+ * @example -
+ *
+ * Test(ParseDocument,
+ *   PeakHeapBudget(64 * 1024)
+ *   AllocCountBudget(100)
+ *   EnumParam(size, 10, 1000))
+ * {
+ *   //Fails if parsing ever needs 64 KiB at once, or 100 allocations
+ *   free_document(parse_document(fixture, size));
+ * }
+ *
+ * */
+#define PeakHeapBudget(bytes)                                                 \
+        if(_gid_is_initializing)                                              \
+          _gid_added_test->peak_heap_budget = (bytes);
+
+/* Limits the number of heap allocations (including reallocations) that the
+ * run step of each configuration of a test may make. This needs
+ * GID_WRAP_MALLOC, and the test fails if it isn't defined.
+ * @param count - The most allocations that may be made. Zero means that the
+ *        run step must not allocate at all.
+ * @remarks - Place this macro among the parameters of the Test. */
+#define AllocCountBudget(count)                                               \
+        if(_gid_is_initializing)                                              \
+          _gid_added_test->alloc_count_budget = (count);
+
+/* Sets how much slower than its baseline each configuration of a Benchmark
+ * may be before it fails (see the GID_BASELINE option).
+ * @param percent - The largest slowdown, as a percentage of the baseline
+ *        time per iteration.
+ * @remarks - Place this macro among the parameters of the Benchmark.
+ * @example -
+ *
+ * Benchmark(SortSpeed,
+ *   RegressionThreshold(50)
+ *   EnumParam(count, 100, 10000))
+ * {
+ *   //Fails if this is more than 1.5 times slower than its baseline
+ *   sort(fixture, count);
+ * }
+ *
+ * */
+#define RegressionThreshold(percent)                                          \
+        if(_gid_is_initializing)                                              \
+          _gid_added_test->regression_threshold = (percent);
+
 /* Defines a row of integer values to pass to the test.
  * Each time the test is run, it will have an 'int64_t* int_row' variable
  * that contains one row of values defined by this macro.
@@ -2287,12 +9217,10 @@ void _gid_test_suite_func_##suite_name()                                      \
         {                                                                     \
           int64_t _gidValues[] = {__VA_ARGS__};                               \
           size_t _gidValueCount = sizeof(_gidValues)/sizeof(int64_t);         \
-          GIDRowParamValue* _gidRow = _gid_create_row_param_value(            \
+          _gid_add_row_param_value(                                           \
+            _gid_int_row_params,                                              \
             _gidValues,                                                       \
-            sizeof(int64_t),                                                  \
-            _gidValueCount,                                                   \
-            GID_ROW_PARAM_TYPE_INT64);                                        \
-          _gid_add_row_param_value(_gid_int_row_params, _gidRow);             \
+            _gidValueCount);                                                  \
         }
 
 /* Defines a row of unsigned integer values to pass to the test.
@@ -2303,17 +9231,17 @@ void _gid_test_suite_func_##suite_name()                                      \
         {                                                                     \
           uint64_t _gidValues[] = {__VA_ARGS__};                              \
           size_t _gidValueCount = sizeof(_gidValues)/sizeof(uint64_t);        \
-          GIDRowParamValue* _gidRow = _gid_create_row_param_value(            \
+          _gid_add_row_param_value(                                           \
+            _gid_uint_row_params,                                             \
             _gidValues,                                                       \
-            sizeof(uint64_t),                                                 \
-            _gidValueCount,                                                   \
-            GID_ROW_PARAM_TYPE_UINT64);                                       \
-          _gid_add_row_param_value(_gid_uint_row_params, _gidRow);            \
+            _gidValueCount);                                                  \
         }
 
 /* Defines a row of string values to pass to the test.
  * This is the same as 'IntRow', except that the values are null-terminated
  * strings and the local variable is 'char** string_row'.
+ * @remarks - The strings aren't copied, so they must stay valid until the
+ *          tests finish, as string literals do.
  * @example -
  *
  * Test(MyTestFunc,
@@ -2333,12 +9261,10 @@ void _gid_test_suite_func_##suite_name()                                      \
         {                                                                     \
           char* _gidValues[] = {__VA_ARGS__};                                 \
           size_t _gidValueCount = sizeof(_gidValues)/sizeof(char*);           \
-          GIDRowParamValue* _gidRow = _gid_create_row_param_value(            \
+          _gid_add_row_param_value(                                           \
+            _gid_string_row_params,                                           \
             _gidValues,                                                       \
-            sizeof(char*),                                                    \
-            _gidValueCount,                                                   \
-            GID_ROW_PARAM_TYPE_STRING);                                       \
-          _gid_add_row_param_value(_gid_string_row_params, _gidRow);          \
+            _gidValueCount);                                                  \
         }
 
 /* Defines a parameter variable that will be tested with a range of signed
@@ -2374,9 +9300,9 @@ void _gid_test_suite_func_##suite_name()                                      \
             _gidVmax, 1);                                                     \
           _gid_add_param(_gid_added_test, _gidParam);                         \
         }                                                                     \
-        else if(_gid_is_this_test_running)                                    \
+        else                                                                  \
         {                                                                     \
-          _gid_read_variable(int64_t, var_name);                              \
+          _gid_read_variable(int64_t, i, var_name);                           \
         }
 
 /* Defines a parameter variable that will be tested with a range of unsigned
@@ -2399,9 +9325,9 @@ void _gid_test_suite_func_##suite_name()                                      \
             0);                                                               \
           _gid_add_param(_gid_added_test, _gidParam);                         \
         }                                                                     \
-        else if(_gid_is_this_test_running)                                    \
+        else                                                                  \
         {                                                                     \
-          _gid_read_variable(uint64_t, var_name);                             \
+          _gid_read_variable(uint64_t, u, var_name);                          \
         }
 
 /* Defines a parameter variable that will be tested with multiple predefined
@@ -2437,9 +9363,9 @@ void _gid_test_suite_func_##suite_name()                                      \
             _gidCount);                                                       \
           _gid_add_param(_gid_added_test, _gidParam);                         \
         }                                                                     \
-        else if(_gid_is_this_test_running)                                    \
+        else                                                                  \
         {                                                                     \
-          _gid_read_variable(int64_t, var_name);                              \
+          _gid_read_variable(int64_t, i, var_name);                           \
         }
 
 /* Defines a parameter variable that will be tested with multiple predefined
@@ -2464,9 +9390,9 @@ void _gid_test_suite_func_##suite_name()                                      \
             _gidCount);                                                       \
           _gid_add_param(_gid_added_test, _gidParam);                         \
         }                                                                     \
-        else if(_gid_is_this_test_running)                                    \
+        else                                                                  \
         {                                                                     \
-          _gid_read_variable(uint64_t, var_name);                             \
+          _gid_read_variable(uint64_t, u, var_name);                          \
         }
 
 /* Defines a parameter variable that will be tested with multiple predefined
@@ -2502,9 +9428,9 @@ void _gid_test_suite_func_##suite_name()                                      \
             _gidCount);                                                       \
           _gid_add_param(_gid_added_test, _gidParam);                         \
         }                                                                     \
-        else if(_gid_is_this_test_running)                                    \
+        else                                                                  \
         {                                                                     \
-          _gid_read_variable(char*, var_name);                                \
+          _gid_read_variable(char*, p, var_name);                             \
         }
 
 